@@ -21,8 +21,11 @@
 #include    <QDomNode>
 #include    <QString>
 #include    <QFile>
+#include    <QSharedPointer>
 #include    <QtGlobal>
 
+struct cfg_index_t;
+
 #if defined(CFG_READER_LIB)
     #define CFG_READER_EXPORT Q_DECL_EXPORT
 #else
@@ -32,6 +35,14 @@
 /*!
  *  \class CfgReader
  *  \brief Work with XML config file
+ *
+ *  Parsed documents are cached process-wide by absolute path, size and
+ *  modification time, so the same config, loaded by many vehicles, devices
+ *  or couplings, is read and parsed once. Cached documents are shared by
+ *  readers and are never modified.
+ *
+ *  Sections and their fields are indexed by name once after parsing, so
+ *  lookups don't walk document. Index is cached with document
  */
 //-----------------------------------------------------------------------------
 //
@@ -46,6 +57,9 @@ public:
     /// Loading of XML file
     bool load(QString path);
 
+    /// Drop parsed documents cache (documents in use aren't affected)
+    static void clearCache();
+
     /// Find first section by name
 	QDomNode getFirstSection(QString section);
     /// Find next section
@@ -81,6 +95,18 @@ private:
 	QDomElement firstElement;
     /// Current document node for parsed file
 	QDomNode curNode;	
+
+    /// Sections and fields index of document
+    QSharedPointer<const cfg_index_t> index;
+    /// Name of current section
+    QString curName;
+    /// Number of current section among sections with the same name
+    int     curPos;
+    /// Index of current section in document (-1 - none)
+    int     curId;
+
+    /// Find section by name and number, update current section
+    QDomNode findSection(const QString &section, int pos);
 };
 
 #endif // CFGREADER_H
@@ -16,11 +16,108 @@
 #include "CfgReader.h"
 #include "convert.h"
 #include <QTextStream>
+#include <QFileInfo>
+#include <QDateTime>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+
+/*!
+ * \struct
+ * \brief Indexed section of document
+ */
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+struct cfg_section_t
+{
+    QDomNode                    node;
+    /// First field with given name
+    QHash<QString, QDomNode>    fields;
+};
+
+/*!
+ * \struct
+ * \brief Index of document sections
+ */
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+struct cfg_index_t
+{
+    /// Sections in document order
+    QVector<cfg_section_t>      sections;
+    /// Indices of sections with given name, in document order
+    QHash<QString, QVector<int>> names;
+};
+
+//-----------------------------------------------------------------------------
+//  Index of root element children and their fields, names are taken as
+//  nodeName(), as in linear search
+//-----------------------------------------------------------------------------
+static QSharedPointer<const cfg_index_t> buildIndex(const QDomDocument &domDoc)
+{
+    cfg_index_t *index = new cfg_index_t();
+
+    QDomNode node = domDoc.documentElement().firstChild();
+
+    while (!node.isNull())
+    {
+        cfg_section_t section;
+        section.node = node;
+
+        QDomNode field = node.firstChild();
+
+        while (!field.isNull())
+        {
+            QString name = field.nodeName();
+
+            if (!section.fields.contains(name))
+                section.fields.insert(name, field);
+
+            field = field.nextSibling();
+        }
+
+        index->names[node.nodeName()].push_back(index->sections.size());
+        index->sections.push_back(section);
+
+        node = node.nextSibling();
+    }
+
+    return QSharedPointer<const cfg_index_t>(index);
+}
+
+/*!
+ * \struct
+ * \brief Parsed document with state of its file
+ */
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+struct cfg_cache_entry_t
+{
+    qint64          size;
+    QDateTime       mtime;
+    QDomDocument    domDoc;
+
+    QSharedPointer<const cfg_index_t> index;
+
+    cfg_cache_entry_t()
+        : size(-1)
+    {
+
+    }
+};
+
+static QHash<QString, cfg_cache_entry_t>    cfg_cache;
+static QMutex                               cfg_cache_mutex;
 
 //-----------------------------------------------------------------------------
 //
 //-----------------------------------------------------------------------------
 CfgReader::CfgReader()
+    : curPos(0)
+    , curId(-1)
 {
 
 }
@@ -38,20 +135,63 @@ CfgReader::~CfgReader()
 //-----------------------------------------------------------------------------
 bool CfgReader::load(QString path)
 {
-    // Try open file
 	file_name = path;
-    QFile file(file_name);
 
-    if (!file.open(QFile::ReadOnly | QFile::Text))
+    QFileInfo info(file_name);
+    QString key = info.absoluteFilePath();
+    qint64 size = info.size();
+    QDateTime mtime = info.lastModified();
+
+    // Take parsed document, if file isn't changed since parsing
+    bool is_cached = false;
+
     {
-		return false;
-	}
+        QMutexLocker locker(&cfg_cache_mutex);
+
+        auto it = cfg_cache.find(key);
+
+        if ( (it != cfg_cache.end()) && (it.value().size == size) && (it.value().mtime == mtime) )
+        {
+            domDoc = it.value().domDoc;
+            index = it.value().index;
+            is_cached = true;
+        }
+    }
+
+    if (!is_cached)
+    {
+        // Try open file
+        QFile file(file_name);
+
+        if (!file.open(QFile::ReadOnly | QFile::Text))
+        {
+            return false;
+        }
+
+        // Read content of file. Parsing is done without lock, so
+        // different files are parsed concurrently
+        bool is_parsed = domDoc.setContent(&file);
+
+        // Close file
+        file.close();
 
-    // Read content of file
-    domDoc.setContent(&file);
+        index = buildIndex(domDoc);
 
-    // Close file
-    file.close();
+        if (is_parsed)
+        {
+            QMutexLocker locker(&cfg_cache_mutex);
+
+            cfg_cache_entry_t &entry = cfg_cache[key];
+            entry.size = size;
+            entry.mtime = mtime;
+            entry.domDoc = domDoc;
+            entry.index = index;
+        }
+    }
+
+    // Current section belongs to previous document
+    curId = -1;
+    curNode = QDomNode();
 
     // Get root element
 	firstElement = domDoc.documentElement();
@@ -65,6 +205,16 @@ bool CfgReader::load(QString path)
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void CfgReader::clearCache()
+{
+    QMutexLocker locker(&cfg_cache_mutex);
+
+    cfg_cache.clear();
+}
+
 //-----------------------------------------------------------------------------
 //
 //-----------------------------------------------------------------------------
@@ -134,34 +284,42 @@ bool CfgReader::getInt(QString section, QString field, int &value)
 //-----------------------------------------------------------------------------
 QDomNode CfgReader::getFirstSection(QString section)
 {
-	QDomNode node = firstElement.firstChild();
-
-	while ( (node.nodeName() != section) && (!node.isNull()) )
-	{
-		node = node.nextSibling();
-	}
+    return findSection(section, 0);
+}
 
-	curNode = node;
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+QDomNode CfgReader::getNextSection()
+{
+    if (curNode.isNull())
+        return curNode;
 
-	return node;
+    return findSection(curName, curPos + 1);
 }
 
 //-----------------------------------------------------------------------------
 //
 //-----------------------------------------------------------------------------
-QDomNode CfgReader::getNextSection()
+QDomNode CfgReader::findSection(const QString &section, int pos)
 {
-	QString section = curNode.nodeName();
-	QDomNode node = curNode.nextSibling();
+    curName = section;
+    curPos = pos;
+    curId = -1;
+    curNode = QDomNode();
 
-	while ((node.nodeName() != section) && (!node.isNull()))
-	{
-		node = node.nextSibling();
-	}
+    if (index.isNull())
+        return curNode;
 
-	curNode = node;
+    auto it = index->names.find(section);
 
-	return node;
+    if ( (it != index->names.end()) && (pos < it.value().size()) )
+    {
+        curId = it.value()[pos];
+        curNode = index->sections[curId].node;
+    }
+
+    return curNode;
 }
 
 //-----------------------------------------------------------------------------
@@ -169,6 +327,16 @@ QDomNode CfgReader::getNextSection()
 //-----------------------------------------------------------------------------
 QDomNode CfgReader::getField(QDomNode secNode, QString field)
 {
+    // Current section is looked up in index
+    if ( (curId >= 0) && (secNode == curNode) )
+    {
+        const QHash<QString, QDomNode> &fields = index->sections[curId].fields;
+        auto it = fields.find(field);
+
+        return (it != fields.end()) ? it.value() : QDomNode();
+    }
+
+    // Other nodes (nested ones, for example) are searched through
 	QDomNode node = secNode.firstChild();
 
 	while ((node.nodeName() != field) && (!node.isNull()))
@@ -6,6 +6,7 @@ SUBDIRS += ./CfgReader
 SUBDIRS += ./CfgEditor
 SUBDIRS += ./filesystem
 SUBDIRS += ./libJournal
+SUBDIRS += ./plugin-loader
 SUBDIRS += ./tcp-connection
 SUBDIRS += ./asound
 SUBDIRS += ./simulator
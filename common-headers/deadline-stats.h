@@ -0,0 +1,127 @@
+//------------------------------------------------------------------------------
+//
+//      Real time deadline statistics of simulation loop
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Real time deadline statistics of simulation loop
+ * \copyright maisvendoo
+ *
+ * Simulator sends this record to TCP client with name "monitor" once per
+ * report interval. Times are in milliseconds. Jitter is deviation of timer
+ * tick period from its nominal interval, percentiles are taken over the
+ * last DEADLINE_JITTER_SAMPLES ticks
+ */
+
+#ifndef     DEADLINE_STATS_H
+#define     DEADLINE_STATS_H
+
+#include    <QtGlobal>
+
+/// Record signature ("SIMD")
+#define     DEADLINE_STATS_MAGIC    0x444D4953u
+
+/// Record layout version
+#define     DEADLINE_STATS_VERSION  1u
+
+/// Number of recent ticks for jitter percentiles
+#define     DEADLINE_JITTER_SAMPLES 1024u
+
+//------------------------------------------------------------------------------
+//  Reaction of simulation loop to missed deadlines
+//------------------------------------------------------------------------------
+enum DeadlinePolicy
+{
+    /// Statistics only, model time per tick is fixed (legacy behaviour)
+    DEADLINE_POLICY_NONE = 0,
+    /// Catch up lag, skip viewer output while late
+    DEADLINE_POLICY_SKIP_OUTPUT = 1,
+    /// Catch up lag, lower viewer output rate while overrun
+    DEADLINE_POLICY_REDUCE_OUTPUT = 2,
+    /// Don't catch up, run slower than real time and report it (warnings
+    /// in journal, is_slipping flag in statistics)
+    DEADLINE_POLICY_SLIP = 3
+};
+
+#pragma pack(push, 1)
+
+/*!
+ * \struct
+ * \brief Deadline statistics record
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct deadline_stats_t
+{
+    quint32     magic;
+    quint16     version;
+    /// Active DeadlinePolicy
+    quint16     policy;
+
+    /// Total number of timer ticks
+    quint64     ticks;
+    /// Ticks, which took longer than interval
+    quint64     overruns;
+    /// Ticks, which started more than one interval late
+    quint64     missed_ticks;
+    /// Viewer outputs, skipped by policy
+    quint64     skipped_outputs;
+    /// Longest series of overruns
+    quint32     max_consecutive_overruns;
+
+    /// Nominal tick interval
+    float       interval;
+    /// Tick period jitter percentiles and maximum
+    float       jitter_p50;
+    float       jitter_p95;
+    float       jitter_p99;
+    float       jitter_max;
+    /// Tick execution time in report window
+    float       exec_mean;
+    float       exec_max;
+    /// Model time per wall time in report window
+    float       realtime_factor;
+    /// Wall time, by which model is behind at the end of window
+    float       lag;
+    /// Total wall time, which model gave up to catch up
+    float       slip_time;
+
+    /// Viewer output interval multiplier
+    quint16     output_divider;
+    /// Model runs slower than real time (slip policy only)
+    quint8      is_slipping;
+    quint8      reserved;
+
+    deadline_stats_t()
+        : magic(DEADLINE_STATS_MAGIC)
+        , version(DEADLINE_STATS_VERSION)
+        , policy(DEADLINE_POLICY_NONE)
+        , ticks(0)
+        , overruns(0)
+        , missed_ticks(0)
+        , skipped_outputs(0)
+        , max_consecutive_overruns(0)
+        , interval(0.0f)
+        , jitter_p50(0.0f)
+        , jitter_p95(0.0f)
+        , jitter_p99(0.0f)
+        , jitter_max(0.0f)
+        , exec_mean(0.0f)
+        , exec_max(0.0f)
+        , realtime_factor(1.0f)
+        , lag(0.0f)
+        , slip_time(0.0f)
+        , output_divider(1)
+        , is_slipping(0)
+        , reserved(0)
+    {
+
+    }
+};
+
+#pragma pack(pop)
+
+#endif // DEADLINE_STATS_H
@@ -19,6 +19,7 @@
 #include    <QString>
 
 #include    "solver-config.h"
+#include    "vehicle-signals.h"
 
 /*!
  * \struct
@@ -32,28 +33,77 @@ struct init_data_t
     double  init_coord;
     double  init_velocity;
     int     direction;
+    /// Payload coefficient for all vehicles (negative - from train config)
+    double  payload_coeff;
     QString profile_path;
     double  prof_step;
+    /// Build uniform grid table of profile with prof_step
+    bool    profile_grid;
+    /// Linear interpolation in profile grid table
+    bool    profile_interpolation;
     QString train_config;
     QString route_dir;
     int     integration_time_interval;
     int     control_time_interval;
+    int     feedback_time_interval;
+    /// Step profiler report interval, ms (used if profiler is built)
+    int     profiler_dump_interval;
+    /// Reaction to missed real time deadlines (none, skip-output, reduce-output, slip)
+    QString deadline_policy;
+    /// Maximal lag to catch up, in integration time intervals
+    double  deadline_catchup_limit;
+    /// Deadline statistics report interval, ms
+    int     deadline_report_interval;
+    /// TCP server port (0 - server is not started)
+    int     server_port;
+    /// Busy wait of simulation timer before tick deadline, us
+    int     scheduler_spin_time;
+    /// Qt events processing interval between timer ticks, us
+    int     scheduler_events_interval;
+    /// CPU core of simulation thread (negative - not pinned)
+    int     scheduler_cpu;
+    /// SCHED_FIFO priority of simulation thread (0 - default scheduling)
+    int     scheduler_priority;
+    /// Copy feedback into old locked "sim" segment (from own thread)
+    bool    legacy_feedback;
+    int     telemetry_analog_signals;
+    int     telemetry_discrete_signals;
+    bool    telemetry_debug;
     int     keys_buffer_size;
     bool    debug_print;
+    bool    sound_enabled;
     solver_config_t solver_config;
 
     init_data_t()
         : init_coord(0)
         , init_velocity(0)
         , direction(1)
+        , payload_coeff(-1.0)
         , profile_path("")
         , prof_step(100.0)
+        , profile_grid(false)
+        , profile_interpolation(true)
         , train_config("")
         , route_dir("")
         , integration_time_interval(100)
         , control_time_interval(50)
+        , feedback_time_interval(20)
+        , profiler_dump_interval(10000)
+        , deadline_policy("none")
+        , deadline_catchup_limit(2.0)
+        , deadline_report_interval(1000)
+        , server_port(0)
+        , scheduler_spin_time(200)
+        , scheduler_events_interval(1000)
+        , scheduler_cpu(-1)
+        , scheduler_priority(0)
+        , legacy_feedback(true)
+        , telemetry_analog_signals(MAX_ANALOG_SIGNALS)
+        , telemetry_discrete_signals(MAX_DISCRETE_SIGNALS)
+        , telemetry_debug(true)
         , keys_buffer_size(1024)
         , debug_print(false)
+        , sound_enabled(true)
     {
 
     }
@@ -0,0 +1,159 @@
+//------------------------------------------------------------------------------
+//
+//      Lock-free shared memory layout of simulator feedback
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Lock-free shared memory layout of simulator feedback
+ * \copyright maisvendoo
+ */
+
+#ifndef     SHARED_FEEDBACK_H
+#define     SHARED_FEEDBACK_H
+
+#include    <atomic>
+#include    <cstring>
+
+#include    "telemetry.h"
+
+/// Shared memory key of feedback segment
+#define     FEEDBACK_SHARED_KEY         "sim-feedback"
+
+/// Segment signature ("SIMF")
+#define     FEEDBACK_MAGIC              0x464D4953u
+
+/// Version of segment layout
+#define     FEEDBACK_LAYOUT_VERSION     2u
+
+/// Number of buffers in segment
+#define     FEEDBACK_BUFFERS_NUM        3u
+
+/// Offset of first buffer from segment begin
+#define     FEEDBACK_BUFFERS_OFFSET     64u
+
+/*!
+ * \struct
+ * \brief Segment header
+ *
+ * Reader must check magic and layout version before reading data
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct feedback_header_t
+{
+    quint32     magic;
+    quint32     layout_version;
+    quint32     buffers_num;
+    /// Maximal telemetry packet size in buffer
+    quint32     buffer_capacity;
+    /// Index of last published buffer
+    std::atomic<quint32>    latest;
+};
+
+/*!
+ * \struct
+ * \brief Buffer, protected by sequence counter
+ *
+ * Buffer header is followed by buffer_capacity bytes for telemetry packet.
+ * Writer makes counter odd before writing and even after it. Data is
+ * consistent, if counter was even and isn't changed while reading
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct feedback_buffer_t
+{
+    std::atomic<quint64>    seq;
+    /// Size of packet in buffer
+    quint32                 size;
+    quint32                 reserved;
+};
+
+//------------------------------------------------------------------------------
+//  Distance between buffers
+//------------------------------------------------------------------------------
+inline size_t feedbackBufferStride(size_t capacity)
+{
+    return (sizeof(feedback_buffer_t) + capacity + 63) & ~static_cast<size_t>(63);
+}
+
+//------------------------------------------------------------------------------
+//  Whole segment size
+//------------------------------------------------------------------------------
+inline size_t feedbackSegmentSize(size_t capacity)
+{
+    return FEEDBACK_BUFFERS_OFFSET + FEEDBACK_BUFFERS_NUM * feedbackBufferStride(capacity);
+}
+
+//------------------------------------------------------------------------------
+//  Buffer by index
+//------------------------------------------------------------------------------
+inline feedback_buffer_t *feedbackBuffer(void *segment, size_t capacity, size_t i)
+{
+    return reinterpret_cast<feedback_buffer_t *>(static_cast<char *>(segment) +
+            FEEDBACK_BUFFERS_OFFSET + i * feedbackBufferStride(capacity));
+}
+
+inline const feedback_buffer_t *feedbackBuffer(const void *segment, size_t capacity, size_t i)
+{
+    return reinterpret_cast<const feedback_buffer_t *>(static_cast<const char *>(segment) +
+            FEEDBACK_BUFFERS_OFFSET + i * feedbackBufferStride(capacity));
+}
+
+//------------------------------------------------------------------------------
+//  Check segment header is compatible with this layout
+//------------------------------------------------------------------------------
+inline bool isFeedbackCompatible(const void *segment, size_t segment_size)
+{
+    const feedback_header_t *header = static_cast<const feedback_header_t *>(segment);
+
+    return (segment_size >= FEEDBACK_BUFFERS_OFFSET) &&
+           (header->magic == FEEDBACK_MAGIC) &&
+           (header->layout_version == FEEDBACK_LAYOUT_VERSION) &&
+           (header->buffers_num == FEEDBACK_BUFFERS_NUM) &&
+           (feedbackSegmentSize(header->buffer_capacity) <= segment_size);
+}
+
+//------------------------------------------------------------------------------
+//  Read last published packet without locks. Packet is copied into
+//  packet buffer with packet_capacity size. Returns false if writer
+//  is too fast and consistent copy is not taken after max_tries attempts
+//------------------------------------------------------------------------------
+inline bool readFeedback(const void *segment,
+                         char *packet,
+                         size_t packet_capacity,
+                         size_t &size,
+                         int max_tries = 8)
+{
+    const feedback_header_t *header = static_cast<const feedback_header_t *>(segment);
+    size_t capacity = header->buffer_capacity;
+
+    for (int i = 0; i < max_tries; ++i)
+    {
+        quint32 idx = header->latest.load(std::memory_order_acquire);
+        const feedback_buffer_t *buffer = feedbackBuffer(segment, capacity,
+                                                         idx % FEEDBACK_BUFFERS_NUM);
+
+        quint64 seq0 = buffer->seq.load(std::memory_order_acquire);
+
+        if (seq0 & 1)
+            continue;
+
+        size = std::min(static_cast<size_t>(buffer->size),
+                        std::min(capacity, packet_capacity));
+
+        memcpy(packet, buffer + 1, size);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+
+        if (buffer->seq.load(std::memory_order_relaxed) == seq0)
+            return true;
+    }
+
+    return false;
+}
+
+#endif // SHARED_FEEDBACK_H
@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------
+//
+//      Lock-free shared memory layout of keyboard state
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Lock-free shared memory layout of keyboard state
+ * \copyright maisvendoo
+ */
+
+#ifndef     SHARED_KEYS_H
+#define     SHARED_KEYS_H
+
+#include    <atomic>
+#include    <cstring>
+
+#include    <QtGlobal>
+
+/// Shared memory key of keyboard segment
+#define     KEYS_SHARED_KEY         "keys"
+
+/// Segment signature ("SIMK")
+#define     KEYS_MAGIC              0x4B4D4953u
+
+/// Version of segment layout
+#define     KEYS_LAYOUT_VERSION     1u
+
+/// Number of key codes in bitset (all codes from key-symbols.h)
+#define     KEYS_CODES_NUM          0x10000u
+
+/// Number of 64-bit words in bitset
+#define     KEYS_WORDS_NUM          (KEYS_CODES_NUM / 64u)
+
+/// Capacity of key events ring buffer
+#define     KEYS_EVENTS_NUM         256u
+
+/// Offset of bitset from segment begin
+#define     KEYS_BITSET_OFFSET      64u
+
+/// Pressed flag in key event
+#define     KEYS_EVENT_PRESSED      0x10000u
+
+/*!
+ * \struct
+ * \brief Segment header
+ *
+ * Header is followed by bitset of KEYS_WORDS_NUM words, where bit of key
+ * code is set while key is pressed, and by ring buffer of KEYS_EVENTS_NUM
+ * key events. Event is key code with KEYS_EVENT_PRESSED flag for press.
+ * Single writer updates bitset first, then stores event and increments
+ * events counter. Reader never locks the segment
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct keys_header_t
+{
+    quint32     magic;
+    quint32     layout_version;
+    quint32     codes_num;
+    quint32     events_num;
+    /// Total number of events, written into ring buffer
+    std::atomic<quint32>    events_count;
+};
+
+//------------------------------------------------------------------------------
+//  Whole segment size
+//------------------------------------------------------------------------------
+inline size_t keysSegmentSize()
+{
+    return KEYS_BITSET_OFFSET +
+           KEYS_WORDS_NUM * sizeof(std::atomic<quint64>) +
+           KEYS_EVENTS_NUM * sizeof(std::atomic<quint32>);
+}
+
+//------------------------------------------------------------------------------
+//  Bitset words
+//------------------------------------------------------------------------------
+inline std::atomic<quint64> *keysBitset(void *segment)
+{
+    return reinterpret_cast<std::atomic<quint64> *>(static_cast<char *>(segment) +
+            KEYS_BITSET_OFFSET);
+}
+
+inline const std::atomic<quint64> *keysBitset(const void *segment)
+{
+    return reinterpret_cast<const std::atomic<quint64> *>(static_cast<const char *>(segment) +
+            KEYS_BITSET_OFFSET);
+}
+
+//------------------------------------------------------------------------------
+//  Events ring buffer
+//------------------------------------------------------------------------------
+inline std::atomic<quint32> *keysEvents(void *segment)
+{
+    return reinterpret_cast<std::atomic<quint32> *>(keysBitset(segment) + KEYS_WORDS_NUM);
+}
+
+inline const std::atomic<quint32> *keysEvents(const void *segment)
+{
+    return reinterpret_cast<const std::atomic<quint32> *>(keysBitset(segment) + KEYS_WORDS_NUM);
+}
+
+//------------------------------------------------------------------------------
+//  Initialize empty segment. Segment must have keysSegmentSize() bytes
+//------------------------------------------------------------------------------
+inline void initKeysSegment(void *segment)
+{
+    memset(static_cast<char *>(segment), 0, keysSegmentSize());
+
+    keys_header_t *header = static_cast<keys_header_t *>(segment);
+
+    header->codes_num = KEYS_CODES_NUM;
+    header->events_num = KEYS_EVENTS_NUM;
+    header->layout_version = KEYS_LAYOUT_VERSION;
+    header->events_count.store(0, std::memory_order_relaxed);
+
+    std::atomic_thread_fence(std::memory_order_release);
+
+    header->magic = KEYS_MAGIC;
+}
+
+//------------------------------------------------------------------------------
+//  Check segment header is compatible with this layout
+//------------------------------------------------------------------------------
+inline bool isKeysCompatible(const void *segment, size_t segment_size)
+{
+    const keys_header_t *header = static_cast<const keys_header_t *>(segment);
+
+    return (segment_size >= keysSegmentSize()) &&
+           (header->magic == KEYS_MAGIC) &&
+           (header->layout_version == KEYS_LAYOUT_VERSION) &&
+           (header->codes_num == KEYS_CODES_NUM) &&
+           (header->events_num == KEYS_EVENTS_NUM);
+}
+
+//------------------------------------------------------------------------------
+//  Key state update by writer (client side)
+//------------------------------------------------------------------------------
+inline void writeSharedKey(void *segment, int key, bool pressed)
+{
+    quint32 code = static_cast<quint32>(key);
+
+    if (code >= KEYS_CODES_NUM)
+        return;
+
+    keys_header_t *header = static_cast<keys_header_t *>(segment);
+    std::atomic<quint64> &word = keysBitset(segment)[code / 64];
+    quint64 bit = static_cast<quint64>(1) << (code % 64);
+
+    if (pressed)
+        word.fetch_or(bit, std::memory_order_relaxed);
+    else
+        word.fetch_and(~bit, std::memory_order_relaxed);
+
+    quint32 count = header->events_count.load(std::memory_order_relaxed);
+
+    keysEvents(segment)[count % KEYS_EVENTS_NUM].store(
+                code | (pressed ? KEYS_EVENT_PRESSED : 0u), std::memory_order_relaxed);
+
+    header->events_count.store(count + 1, std::memory_order_release);
+}
+
+#endif // SHARED_KEYS_H
@@ -20,6 +20,16 @@ struct simulator_command_line_t
     option_t<double>    init_coord;
     /// Initial direction
     option_t<int>       direction;
+    /// Initial velocity, km/h
+    option_t<double>    init_velocity;
+    /// Payload coefficient for all vehicles
+    option_t<double>    payload_coeff;
+    /// Headless simulation from start to stop time without real time pacing
+    option_t<bool>      batch_mode;
+    /// Batch mode output file
+    option_t<QString>   batch_output;
+    /// Timed keys events for batch mode
+    option_t<QString>   control_script;
 };
 
 #endif // SIMULATOR_COMMAND_LINE
@@ -39,6 +39,11 @@ struct solver_config_t
     double      max_step;
     /// Local error of solution
     double      local_error;
+    /// Own integration step of brakepipe (0 - synchronous with train motion)
+    double      brakepipe_step;
+    /// Own integration step of vehicles and theirs devices
+    /// (0 - synchronous with train motion)
+    double      vehicles_step;
 
     solver_config_t()
         : method("rkf5")
@@ -47,6 +52,8 @@ struct solver_config_t
         , step(1e-3)
         , max_step(1e-2)
         , local_error(1e-5)
+        , brakepipe_step(0.0)
+        , vehicles_step(0.0)
     {
 
     }
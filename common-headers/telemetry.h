@@ -0,0 +1,405 @@
+//------------------------------------------------------------------------------
+//
+//      Compact binary telemetry packet
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Compact binary telemetry packet
+ * \copyright maisvendoo
+ *
+ * Packet layout (all blocks follow each other without gaps):
+ *
+ *  telemetry_header_t
+ *  telemetry_kinematics_t  [vehicles_num]                  (KINEMATICS set)
+ *  float                   [vehicles_num * analog_num]     (ANALOG set)
+ *  quint8                  [vehicles_num * discrete_bytes] (DISCRETE set)
+ *  debug_num records of telemetry_debug_t, each followed
+ *  by size bytes of UTF-8 string                           (DEBUG set)
+ *
+ * Discrete signals are packed by 8 in byte, lower bit first.
+ *
+ * In delta packets (DELTA flag) analog and discrete blocks contain changes
+ * since previous packet of the stream:
+ *
+ *  analog:   vehicles mask [vehicles_bytes], then for each marked vehicle
+ *            signals mask [analog_bytes] and changed values [changed count]
+ *  discrete: vehicles mask [vehicles_bytes], then for each marked vehicle
+ *            XOR-mask of changed signals [discrete_bytes]
+ *
+ * Delta packet may be applied only to the packet with previous sequence
+ * number. Stream periodically sends keyframes (KEYFRAME flag, full blocks),
+ * so receiver resynchronizes after lost or skipped packets
+ */
+
+#ifndef     TELEMETRY_H
+#define     TELEMETRY_H
+
+#include    <QString>
+#include    <cstring>
+#include    <algorithm>
+
+#include    "server-data-struct.h"
+
+/// Packet signature ("SIMT")
+#define     TELEMETRY_MAGIC     0x544D4953u
+
+/// Packet layout version
+#define     TELEMETRY_VERSION   2u
+
+//------------------------------------------------------------------------------
+//  Signal sets
+//------------------------------------------------------------------------------
+enum
+{
+    TELEMETRY_KINEMATICS = 1 << 0,
+    TELEMETRY_ANALOG = 1 << 1,
+    TELEMETRY_DISCRETE = 1 << 2,
+    TELEMETRY_DEBUG = 1 << 3,
+
+    /// Analog and discrete blocks are changes since previous packet
+    TELEMETRY_DELTA = 1 << 14,
+    /// Full packet, which starts delta sequence
+    TELEMETRY_KEYFRAME = 1 << 15
+};
+
+#pragma pack(push, 1)
+
+/*!
+ * \struct
+ * \brief Packet header
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct telemetry_header_t
+{
+    quint32     magic;
+    quint16     version;
+    /// Header size (for future extension of header)
+    quint16     header_size;
+    /// Whole packet size
+    quint32     packet_size;
+    quint32     route_id;
+    /// Model's feedback counter
+    quint64     count;
+    /// Sequence number of packet in stream
+    quint32     sequence;
+    float       time;
+    /// Number of vehicles in packet
+    quint16     vehicles_num;
+    /// Signal sets flags
+    quint16     signal_sets;
+    /// Analog signals per vehicle
+    quint16     analog_num;
+    /// Discrete signals per vehicle
+    quint16     discrete_num;
+    /// Number of debug string records
+    quint16     debug_num;
+};
+
+/*!
+ * \struct
+ * \brief Vehicle's kinematic data
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct telemetry_kinematics_t
+{
+    float   coord;
+    float   velocity;
+    float   angle;
+    float   omega;
+};
+
+/*!
+ * \struct
+ * \brief Debug string record
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct telemetry_debug_t
+{
+    /// Vehicle index
+    quint16 vehicle;
+    /// UTF-8 string size
+    quint16 size;
+};
+
+#pragma pack(pop)
+
+//------------------------------------------------------------------------------
+//  Bytes of packed discrete signals per vehicle
+//------------------------------------------------------------------------------
+inline size_t telemetryDiscreteBytes(size_t discrete_num)
+{
+    return (discrete_num + 7) / 8;
+}
+
+//------------------------------------------------------------------------------
+//  Bytes of bit mask
+//------------------------------------------------------------------------------
+inline size_t telemetryMaskBytes(size_t bits_num)
+{
+    return (bits_num + 7) / 8;
+}
+
+//------------------------------------------------------------------------------
+//  Maximal packet size
+//------------------------------------------------------------------------------
+inline size_t telemetryMaxSize(size_t vehicles_num,
+                               size_t analog_num,
+                               size_t discrete_num,
+                               bool is_debug)
+{
+    size_t size = sizeof(telemetry_header_t);
+
+    size += vehicles_num * sizeof(telemetry_kinematics_t);
+    size += vehicles_num * analog_num * sizeof(float);
+    size += vehicles_num * telemetryDiscreteBytes(discrete_num);
+
+    // UTF-16 code unit takes no more than 3 bytes in UTF-8
+    if (is_debug)
+        size += vehicles_num * (sizeof(telemetry_debug_t) + 3 * (DEBUG_STRING_SIZE - 1));
+
+    return size;
+}
+
+//------------------------------------------------------------------------------
+//  Bounds checked packet reading
+//------------------------------------------------------------------------------
+struct telemetry_reader_t
+{
+    const char *ptr;
+    const char *end;
+
+    bool take(void *dst, size_t size)
+    {
+        if (static_cast<size_t>(end - ptr) < size)
+            return false;
+
+        memcpy(dst, ptr, size);
+        ptr += size;
+
+        return true;
+    }
+
+    const char *skip(size_t size)
+    {
+        if (static_cast<size_t>(end - ptr) < size)
+            return nullptr;
+
+        const char *p = ptr;
+        ptr += size;
+
+        return p;
+    }
+};
+
+//------------------------------------------------------------------------------
+//  Compatibility shim: convert packet into old fixed structure.
+//
+//  Full packets reset signals, which are absent in packet, to zero.
+//  Delta packets are applied to data, decoded from previous packet of
+//  the stream, so last_sequence must be given for delta streams. If packet
+//  doesn't follow last_sequence, it is rejected till next keyframe
+//------------------------------------------------------------------------------
+inline bool telemetryToServerData(const char *packet,
+                                  size_t size,
+                                  server_data_t &data,
+                                  quint32 *last_sequence = nullptr)
+{
+    if (size < sizeof(telemetry_header_t))
+        return false;
+
+    telemetry_header_t header;
+    memcpy(&header, packet, sizeof(telemetry_header_t));
+
+    if ( (header.magic != TELEMETRY_MAGIC) ||
+         (header.version != TELEMETRY_VERSION) ||
+         (header.header_size < sizeof(telemetry_header_t)) ||
+         (header.packet_size > size) ||
+         (header.vehicles_num > MAX_NUM_VEHICLES) )
+    {
+        return false;
+    }
+
+    bool is_delta = (header.signal_sets & TELEMETRY_DELTA) != 0;
+
+    if (is_delta &&
+        ( (last_sequence == nullptr) || (header.sequence != *last_sequence + 1) ))
+    {
+        return false;
+    }
+
+    size_t n = header.vehicles_num;
+    size_t analog_num = std::min(static_cast<size_t>(header.analog_num),
+                                 static_cast<size_t>(MAX_ANALOG_SIGNALS));
+    size_t discrete_num = std::min(static_cast<size_t>(header.discrete_num),
+                                   static_cast<size_t>(MAX_DISCRETE_SIGNALS));
+    size_t analog_bytes = telemetryMaskBytes(header.analog_num);
+    size_t discrete_bytes = telemetryDiscreteBytes(header.discrete_num);
+    size_t vehicles_bytes = telemetryMaskBytes(n);
+
+    telemetry_reader_t reader;
+    reader.ptr = packet + header.header_size;
+    reader.end = packet + header.packet_size;
+
+    if (reader.ptr > reader.end)
+        return false;
+
+    // Broken packet may be applied partially, but sequence is not
+    // updated then, so delta stream waits for next keyframe
+    server_data_t &out = data;
+
+    out.route_id = header.route_id;
+    out.time = header.time;
+    out.count = static_cast<unsigned long>(header.count);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        vehicle_data_t &vd = out.te[i];
+
+        vd.DebugMsg[0] = L'\0';
+
+        if (!is_delta)
+        {
+            std::fill(vd.analogSignal.begin(), vd.analogSignal.end(), 0.0f);
+            std::fill(vd.discreteSignal.begin(), vd.discreteSignal.end(), false);
+        }
+    }
+
+    if (header.signal_sets & TELEMETRY_KINEMATICS)
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            telemetry_kinematics_t k;
+
+            if (!reader.take(&k, sizeof(k)))
+                return false;
+
+            out.te[i].coord = k.coord;
+            out.te[i].velocity = k.velocity;
+            out.te[i].angle = k.angle;
+            out.te[i].omega = k.omega;
+        }
+    }
+
+    if ( (header.signal_sets & TELEMETRY_ANALOG) && !is_delta )
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            const char *values = reader.skip(header.analog_num * sizeof(float));
+
+            if (values == nullptr)
+                return false;
+
+            memcpy(out.te[i].analogSignal.data(), values, analog_num * sizeof(float));
+        }
+    }
+
+    if ( (header.signal_sets & TELEMETRY_ANALOG) && is_delta )
+    {
+        const quint8 *vmask = reinterpret_cast<const quint8 *>(reader.skip(vehicles_bytes));
+
+        if (vmask == nullptr)
+            return false;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            if ( !((vmask[i / 8] >> (i % 8)) & 1) )
+                continue;
+
+            const quint8 *smask = reinterpret_cast<const quint8 *>(reader.skip(analog_bytes));
+
+            if (smask == nullptr)
+                return false;
+
+            for (size_t j = 0; j < header.analog_num; ++j)
+            {
+                if ( !((smask[j / 8] >> (j % 8)) & 1) )
+                    continue;
+
+                float value = 0.0f;
+
+                if (!reader.take(&value, sizeof(float)))
+                    return false;
+
+                if (j < analog_num)
+                    out.te[i].analogSignal[j] = value;
+            }
+        }
+    }
+
+    if ( (header.signal_sets & TELEMETRY_DISCRETE) && !is_delta )
+    {
+        for (size_t i = 0; i < n; ++i)
+        {
+            const quint8 *bits = reinterpret_cast<const quint8 *>(reader.skip(discrete_bytes));
+
+            if (bits == nullptr)
+                return false;
+
+            for (size_t j = 0; j < discrete_num; ++j)
+                out.te[i].discreteSignal[j] = (bits[j / 8] >> (j % 8)) & 1;
+        }
+    }
+
+    if ( (header.signal_sets & TELEMETRY_DISCRETE) && is_delta )
+    {
+        const quint8 *vmask = reinterpret_cast<const quint8 *>(reader.skip(vehicles_bytes));
+
+        if (vmask == nullptr)
+            return false;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            if ( !((vmask[i / 8] >> (i % 8)) & 1) )
+                continue;
+
+            const quint8 *bits = reinterpret_cast<const quint8 *>(reader.skip(discrete_bytes));
+
+            if (bits == nullptr)
+                return false;
+
+            for (size_t j = 0; j < discrete_num; ++j)
+            {
+                if ((bits[j / 8] >> (j % 8)) & 1)
+                    out.te[i].discreteSignal[j] = !out.te[i].discreteSignal[j];
+            }
+        }
+    }
+
+    if (header.signal_sets & TELEMETRY_DEBUG)
+    {
+        for (size_t r = 0; r < header.debug_num; ++r)
+        {
+            telemetry_debug_t rec;
+
+            if (!reader.take(&rec, sizeof(rec)))
+                return false;
+
+            const char *str = reader.skip(rec.size);
+
+            if (str == nullptr)
+                return false;
+
+            if (rec.vehicle < n)
+            {
+                QString msg = QString::fromUtf8(str, rec.size).left(DEBUG_STRING_SIZE - 1);
+                int len = msg.toWCharArray(out.te[rec.vehicle].DebugMsg);
+                out.te[rec.vehicle].DebugMsg[len] = L'\0';
+            }
+        }
+    }
+
+    if (last_sequence != nullptr)
+        *last_sequence = header.sequence;
+
+    return true;
+}
+
+#endif // TELEMETRY_H
@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+//
+//      Process-wide registry of plugin modules
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Process-wide registry of plugin modules
+ * \copyright maisvendoo
+ */
+
+#ifndef     MODULE_REGISTRY_H
+#define     MODULE_REGISTRY_H
+
+#include    <QString>
+#include    <QByteArray>
+#include    <QHash>
+#include    <QMutex>
+#include    <QLibrary>
+
+#if defined(PLUGIN_LOADER_LIB)
+    #define PLUGIN_LOADER_EXPORT    Q_DECL_EXPORT
+#else
+    #define PLUGIN_LOADER_EXPORT    Q_DECL_IMPORT
+#endif
+
+/*!
+ * \class
+ * \brief Shared libraries of modules, loaded once per process
+ *
+ * Every library is loaded on first request, its resolved symbols are cached,
+ * so next instances of vehicle, coupling or device from the same module
+ * cost only factory call. Libraries aren't unloaded, because objects created
+ * by them live till process exit
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class PLUGIN_LOADER_EXPORT ModuleRegistry
+{
+public:
+
+    static ModuleRegistry *instance();
+
+    /// Resolve symbol of module library (nullptr on error)
+    QFunctionPointer resolve(const QString &lib_path, const char *symbol);
+
+    /// Resolve factory function of module library
+    template <typename F>
+    F resolve(const QString &lib_path, const char *symbol)
+    {
+        return reinterpret_cast<F>(resolve(lib_path, symbol));
+    }
+
+    /// Log load times and requests count of modules
+    void report();
+
+private:
+
+    struct module_t
+    {
+        QLibrary    *lib;
+        bool        is_loaded;
+        /// Time of library load, ns
+        qint64      load_time;
+        /// Number of resolve requests
+        quint64     requests;
+
+        QHash<QByteArray, QFunctionPointer> symbols;
+
+        module_t()
+            : lib(nullptr)
+            , is_loaded(false)
+            , load_time(0)
+            , requests(0)
+        {
+
+        }
+    };
+
+    QHash<QString, module_t> modules;
+
+    QMutex  mutex;
+
+    ModuleRegistry();
+
+    ~ModuleRegistry();
+
+    Q_DISABLE_COPY(ModuleRegistry)
+};
+
+#endif // MODULE_REGISTRY_H
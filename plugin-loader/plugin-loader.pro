@@ -0,0 +1,27 @@
+TEMPLATE = lib
+
+QT -= gui
+
+CONFIG += c++11
+
+DEFINES += PLUGIN_LOADER_LIB
+
+TARGET = plugin-loader
+
+DESTDIR = ../../lib
+
+CONFIG(debug, debug|release) {
+
+    TARGET = $$join(TARGET,,,_d)
+    LIBS += -L../../lib -lJournal_d
+
+} else {
+
+    LIBS += -L../../lib -lJournal
+}
+
+INCLUDEPATH += ./include
+INCLUDEPATH += ../libJournal/include
+
+HEADERS += $$files(./include/*.h)
+SOURCES += $$files(./src/*.cpp)
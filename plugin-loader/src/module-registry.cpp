@@ -0,0 +1,116 @@
+//------------------------------------------------------------------------------
+//
+//      Process-wide registry of plugin modules
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Process-wide registry of plugin modules
+ * \copyright maisvendoo
+ */
+
+#include    "module-registry.h"
+
+#include    <QElapsedTimer>
+#include    <QMutexLocker>
+
+#include    "Journal.h"
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+ModuleRegistry::ModuleRegistry()
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+ModuleRegistry::~ModuleRegistry()
+{
+    // Libraries stay loaded, QLibrary objects only are released
+    for (auto it = modules.begin(); it != modules.end(); ++it)
+        delete it.value().lib;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+ModuleRegistry *ModuleRegistry::instance()
+{
+    static ModuleRegistry registry;
+    return &registry;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+QFunctionPointer ModuleRegistry::resolve(const QString &lib_path, const char *symbol)
+{
+    QMutexLocker locker(&mutex);
+
+    module_t &module = modules[lib_path];
+    module.requests++;
+
+    if (module.lib == nullptr)
+    {
+        module.lib = new QLibrary(lib_path);
+
+        QElapsedTimer timer;
+        timer.start();
+
+        module.is_loaded = module.lib->load();
+        module.load_time = timer.nsecsElapsed();
+
+        // Error is reported once, failed module isn't loaded again
+        if (!module.is_loaded)
+            Journal::instance()->error(module.lib->errorString());
+    }
+
+    if (!module.is_loaded)
+        return nullptr;
+
+    QByteArray name(symbol);
+    auto it = module.symbols.find(name);
+
+    if (it != module.symbols.end())
+        return it.value();
+
+    QFunctionPointer func = module.lib->resolve(symbol);
+
+    if (func == nullptr)
+        Journal::instance()->error(module.lib->errorString());
+
+    module.symbols.insert(name, func);
+
+    return func;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void ModuleRegistry::report()
+{
+    QMutexLocker locker(&mutex);
+
+    qint64 total_time = 0;
+
+    for (auto it = modules.begin(); it != modules.end(); ++it)
+    {
+        const module_t &module = it.value();
+
+        Journal::instance()->info(QString("Module %1: %2, loaded in %3 ms, %4 requests")
+                                  .arg(it.key())
+                                  .arg(module.is_loaded ? "OK" : "FAIL")
+                                  .arg(module.load_time / 1.0e6, 0, 'f', 3)
+                                  .arg(module.requests));
+
+        total_time += module.load_time;
+    }
+
+    Journal::instance()->info(QString("Modules: %1 libraries loaded in %2 ms")
+                              .arg(modules.size())
+                              .arg(total_time / 1.0e6, 0, 'f', 3));
+}
@@ -0,0 +1,43 @@
+TEMPLATE = app
+
+QT -= gui
+QT += core xml
+
+CONFIG += c++11
+CONFIG += console
+CONFIG -= app_bundle
+
+DESTDIR += ../../../bin
+
+TARGET = acceleration-benchmark
+
+CONFIG(debug, debug|release) {
+
+    TARGET = $$join(TARGET,,,_d)
+
+    LIBS += -L../../../lib -lvehicle_d
+    LIBS += -L../../../lib -ldevice_d
+    LIBS += -L../../../lib -lphysics_d
+    LIBS += -L../../../lib -lCfgReader_d
+    LIBS += -L../../../lib -lJournal_d
+    LIBS += -L../../../lib -lplugin-loader_d
+
+} else {
+
+    LIBS += -L../../../lib -lvehicle
+    LIBS += -L../../../lib -ldevice
+    LIBS += -L../../../lib -lphysics
+    LIBS += -L../../../lib -lCfgReader
+    LIBS += -L../../../lib -lJournal
+    LIBS += -L../../../lib -lplugin-loader
+}
+
+INCLUDEPATH += ../../common-headers/
+INCLUDEPATH += ../vehicle/include
+INCLUDEPATH += ../solver/include
+INCLUDEPATH += ../physics/include
+INCLUDEPATH += ../device/include
+INCLUDEPATH += ../../CfgReader/include
+INCLUDEPATH += ../../libJournal/include
+
+SOURCES += $$files(./src/*.cpp)
@@ -0,0 +1,218 @@
+//------------------------------------------------------------------------------
+//
+//      Benchmark of vehicle acceleration APIs
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Benchmark of vehicle acceleration APIs
+ * \copyright maisvendoo
+ *
+ * Train of identical vehicles, accelerations are calculated as in
+ * Train::calcDerivative for 6 stages of RKF5 step, through legacy
+ * getAcceleration() and through calcAcceleration() into dYdt slice.
+ * Heap allocations are counted by replaced operator new
+ */
+
+#include    <QCoreApplication>
+#include    <QTemporaryDir>
+#include    <QFile>
+
+#include    <atomic>
+#include    <chrono>
+#include    <cstdio>
+#include    <cstdlib>
+#include    <cstring>
+#include    <new>
+
+#include    "vehicle.h"
+
+static std::atomic<quint64> allocations(0);
+
+//------------------------------------------------------------------------------
+//  Allocations counter
+//------------------------------------------------------------------------------
+void *operator new(size_t size)
+{
+    allocations++;
+
+    void *ptr = malloc(size ? size : 1);
+
+    if (ptr == nullptr)
+        throw std::bad_alloc();
+
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
+void operator delete(void *ptr, size_t) noexcept
+{
+    free(ptr);
+}
+
+/*!
+ * \class
+ * \brief Vehicle, which doesn't override legacy API
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class BenchVehicle : public Vehicle
+{
+public:
+
+    BenchVehicle(bool is_native)
+    {
+        setNativeAcceleration(is_native);
+    }
+};
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct bench_result_t
+{
+    double  step_time;
+    double  allocations;
+    double  checksum;
+};
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static bench_result_t run(const QString &cfg_path,
+                          size_t vehicles_num,
+                          bool is_native,
+                          bool is_legacy_call,
+                          int steps)
+{
+    const int STAGES = 6;
+
+    std::vector<Vehicle *> vehicles;
+    size_t ode_order = 0;
+
+    for (size_t i = 0; i < vehicles_num; i++)
+    {
+        Vehicle *vehicle = new BenchVehicle(is_native);
+        vehicle->init(cfg_path);
+        vehicle->setIndex(ode_order);
+
+        ode_order += 2 * vehicle->getDegressOfFreedom();
+        vehicles.push_back(vehicle);
+    }
+
+    state_vector_t Y(ode_order, 0.0);
+    state_vector_t dYdt(ode_order, 0.0);
+
+    for (auto vehicle : vehicles)
+        Y[vehicle->getIndex() + vehicle->getDegressOfFreedom()] = 10.0;
+
+    quint64 alloc_begin = allocations;
+    auto t0 = std::chrono::steady_clock::now();
+
+    for (int step = 0; step < steps; step++)
+    {
+        for (int stage = 0; stage < STAGES; stage++)
+        {
+            double t = step * 1e-3;
+
+            for (auto vehicle : vehicles)
+            {
+                size_t idx = vehicle->getIndex();
+                size_t s = vehicle->getDegressOfFreedom();
+
+                if (is_legacy_call)
+                {
+                    // Train::calcDerivative before allocation-free API
+                    state_vector_t a = vehicle->getAcceleration(Y, t);
+                    memcpy(dYdt.data() + idx + s, a.data(), sizeof(double) * s);
+                }
+                else
+                {
+                    vehicle->calcAcceleration(Y, t, dYdt.data() + idx + s);
+                }
+            }
+        }
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    bench_result_t result;
+    result.step_time = std::chrono::duration<double, std::micro>(t1 - t0).count() / steps;
+    result.allocations = static_cast<double>(allocations - alloc_begin) / steps;
+    result.checksum = 0;
+
+    for (double x : dYdt)
+        result.checksum += x;
+
+    for (auto vehicle : vehicles)
+        delete vehicle;
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QTemporaryDir dir;
+
+    if (!dir.isValid())
+        return 1;
+
+    // Minimal freight car config
+    QString cfg_path = dir.path() + "/vehicle.xml";
+    QFile cfg(cfg_path);
+
+    if (!cfg.open(QFile::WriteOnly | QFile::Text))
+        return 1;
+
+    cfg.write("<?xml version='1.0' encoding='UTF-8'?>\n"
+              "<Config>\n"
+              "    <Vehicle>\n"
+              "        <EmptyMass>24000</EmptyMass>\n"
+              "        <PayloadMass>68000</PayloadMass>\n"
+              "        <Length>14.7</Length>\n"
+              "        <WheelDiameter>0.95</WheelDiameter>\n"
+              "        <NumAxis>4</NumAxis>\n"
+              "        <WheelInertia>2.0</WheelInertia>\n"
+              "    </Vehicle>\n"
+              "</Config>\n");
+    cfg.close();
+
+    const int steps = 2000;
+
+    fputs("vehicles  API                       us/step   allocs/step  checksum\n", stdout);
+
+    for (size_t vehicles_num : {60, 180})
+    {
+        struct
+        {
+            const char *name;
+            bool is_native;
+            bool is_legacy_call;
+        } modes[] = {
+            { "getAcceleration (old)",  false, true  },
+            { "calcAcceleration shim",  false, false },
+            { "calcAcceleration native", true, false }
+        };
+
+        for (auto &mode : modes)
+        {
+            bench_result_t r = run(cfg_path, vehicles_num, mode.is_native, mode.is_legacy_call, steps);
+
+            fprintf(stdout, "%8zu  %-24s %9.2f %12.1f  %.9g\n",
+                    vehicles_num, mode.name, r.step_time, r.allocations, r.checksum);
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,33 @@
+TEMPLATE = app
+
+QT -= gui
+QT += core xml
+
+CONFIG += c++11
+CONFIG += console
+CONFIG -= app_bundle
+
+DESTDIR += ../../../bin
+
+TARGET = brakepipe-benchmark
+
+CONFIG(debug, debug|release) {
+
+    TARGET = $$join(TARGET,,,_d)
+
+    LIBS += -L../../../lib -lbrakepipe_d
+    LIBS += -L../../../lib -lphysics_d
+    LIBS += -L../../../lib -lCfgReader_d
+
+} else {
+
+    LIBS += -L../../../lib -lbrakepipe
+    LIBS += -L../../../lib -lphysics
+    LIBS += -L../../../lib -lCfgReader
+}
+
+INCLUDEPATH += ../brakepipe/include
+INCLUDEPATH += ../physics/include
+INCLUDEPATH += ../../CfgReader/include
+
+SOURCES += $$files(./src/*.cpp)
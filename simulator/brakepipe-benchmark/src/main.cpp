@@ -0,0 +1,96 @@
+//------------------------------------------------------------------------------
+//
+//      Benchmark of brakepipe step
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Benchmark of brakepipe step
+ * \copyright maisvendoo
+ *
+ * Brakepipe with a node per vehicle and default parameters is stepped with
+ * fixed dt. Two cases are timed: constant begin pressure, when step only
+ * builds right part and solves prefactored system, and begin pressure
+ * changed every step, when leak terms are refreshed too
+ */
+
+#include    <QCoreApplication>
+
+#include    <chrono>
+#include    <cstdio>
+
+#include    "brakepipe.h"
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct bench_result_t
+{
+    double  step_time;
+    double  checksum;
+};
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static bench_result_t run(size_t nodes_num, bool is_p0_varying, int steps)
+{
+    const double dt = 1e-3;
+    const double p0 = 0.5 * Physics::MPa + Physics::pA;
+
+    BrakePipe brakepipe;
+    brakepipe.setLength(nodes_num * 15.0);
+    brakepipe.setNodesNum(nodes_num);
+    brakepipe.setBeginPressure(p0);
+    brakepipe.init("");
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    for (int step = 0; step < steps; step++)
+    {
+        // Service braking: begin pressure goes down by 1 kPa per second
+        if (is_p0_varying)
+            brakepipe.setBeginPressure(p0 - 1e3 * step * dt);
+
+        brakepipe.setAuxRate(nodes_num / 2, -1e-3);
+        brakepipe.step(step * dt, dt);
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    bench_result_t result;
+    result.step_time = std::chrono::duration<double, std::nano>(t1 - t0).count() / steps;
+    result.checksum = 0;
+
+    for (size_t i = 0; i <= nodes_num + 1; i++)
+        result.checksum += brakepipe.getPressure(i);
+
+    return result;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    const int steps = 200000;
+
+    fputs("nodes  begin pressure  ns/step   checksum\n", stdout);
+
+    for (size_t nodes_num : {50, 100, 200})
+    {
+        for (bool is_p0_varying : {false, true})
+        {
+            bench_result_t r = run(nodes_num, is_p0_varying, steps);
+
+            fprintf(stdout, "%5zu  %-14s %8.1f   %.9g\n",
+                    nodes_num, is_p0_varying ? "varying" : "constant",
+                    r.step_time, r.checksum);
+        }
+    }
+
+    return 0;
+}
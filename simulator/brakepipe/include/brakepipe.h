@@ -20,6 +20,7 @@
 #include    <QtGlobal>
 
 #include    "physics.h"
+#include    "sweep-batch.h"
 
 #include    <vector>
 
@@ -48,7 +49,7 @@ public:
     /// Set brakepipe length
     void setLength(double L);
 
-    /// Set nodes count
+    /// Set nodes count (number of vehicles, connected to pipe)
     void setNodesNum(size_t N);
 
     /// Set pressure in begin node of pipe
@@ -66,6 +67,25 @@ public:
     /// Get pressure in node
     double getPressure(size_t i);
 
+    /// Number of grid nodes (may differ from vehicles number)
+    size_t getGridNodesNum() const;
+
+    /// Order of node's equations system
+    size_t getOrder() const;
+
+    /// Update grid and cached leak terms for time step. Returns true,
+    /// if geometry is changed and matrix must be rebuilt
+    bool prepare(double dt);
+
+    /// Write matrix of node's equations for time step as system k of batch
+    void setMatrix(SweepBatch &batch, size_t k, double dt) const;
+
+    /// Write right part of node's equations into f with given stride
+    void setRightPart(double *f, size_t stride, double dt) const;
+
+    /// Take node's pressures from solution x with given stride
+    void setSolution(const double *x, size_t stride);
+
 private:
 
     double lambda;          ///< Air friction coefficient
@@ -73,7 +93,35 @@ private:
     double T;               ///< Air temperature
     double muf;             ///< Equal hode area (for 1 meter of pipe)
 
-    size_t N;                  ///< Nodes count
+    size_t N;                  ///< Grid nodes count
+
+    /// Grid nodes per meter (0 - node per vehicle)
+    double nodes_per_meter;
+
+    /// Move grid nodes to pressure fronts
+    bool    is_adaptive;
+    /// Maximal ratio of nodes density near front to density far from it
+    double  refine_factor;
+    /// Interval of grid adaptation, s
+    double  adapt_interval;
+    /// Time from last grid adaptation, s
+    double  adapt_time;
+    /// Pressures in nodes at last grid adaptation
+    std::vector<double> p_adapt;
+
+    /// Grid nodes coincide with vehicles
+    bool    is_tap_grid;
+
+    /// Vehicles number
+    size_t  taps_num;
+    /// Grid cell, containing vehicle (begin and end of pipe included)
+    std::vector<size_t> tap_cell;
+    /// Position of vehicle in grid cell (0 - left node, 1 - right node)
+    std::vector<double> tap_weight;
+    /// Pressure rates, set by vehicles
+    std::vector<double> tap_rate;
+    /// Ratio of vehicle's pipe segment length to volume length of nodes
+    std::vector<double> node_scale;
 
     double c0;
     double a;
@@ -83,16 +131,44 @@ private:
     std::vector<double> p;              ///< Pressures in nodes
     std::vector<double> V;              ///< Pressure rate in node
 
-    std::vector<double> A;              ///< Bottom matrix diagonal of node's equations
-    std::vector<double> B;              ///< Top matrix diagonal of node's equations
-    std::vector<double> C;              ///< Main matrix diagonal of node's equations
     std::vector<double> f;              ///< Right part column
 
-    double h;
+    std::vector<double> x;              ///< Nodes coordinates
+    std::vector<double> dx;             ///< Grid steps
+
+    /// Solver of node's equations, if pipe is solved alone
+    SweepBatch  solver;
+
+    /// Leak factors of nodes (leak is p[0] * factor), depend on geometry only
+    std::vector<double> leak_factor;
+    /// Leak in nodes for cached_p0
+    std::vector<double> leak;
+
+    /// Time step, solver matrix is factorized for
+    double cached_dt;
+    /// Begin pressure, leak is calculated for
+    double cached_p0;
+    /// Leak is calculated for current leak factors and cached_p0
+    bool   is_leak_valid;
 
     /// Leak function
     double Q(size_t i);
 
+    /// Leak factors calculation (after geometry change)
+    void updateLeakFactors();
+
+    /// Uniform grid of N nodes
+    void resizeGrid(size_t N);
+
+    /// Vehicles positions at grid calculation
+    void updateTaps();
+
+    /// Pressure rates of grid nodes from vehicles rates
+    void updateRates();
+
+    /// Move nodes to pressure fronts. Returns true, if grid is changed
+    bool adaptGrid();
+
     /// Config loading
     bool loadCfg(QString cfg_path);
 };
@@ -0,0 +1,66 @@
+//------------------------------------------------------------------------------
+//
+//      Batch of brakepipes solved together
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Batch of brakepipes solved together
+ * \copyright maisvendoo
+ */
+
+#ifndef     PIPE_BATCH_H
+#define     PIPE_BATCH_H
+
+#include    "brakepipe.h"
+
+/*!
+ * \class
+ * \brief Several independent pipes (brakepipe, feed line) of train
+ *
+ * Node's equations of all pipes are solved by one call of batched sweep.
+ * Pipes aren't owned by batch
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class BRAKEPIPE_EXPORT PipeBatch
+{
+public:
+
+    PipeBatch();
+
+    ~PipeBatch();
+
+    /// Add pipe to batch
+    void addPipe(BrakePipe *pipe);
+
+    /// Number of pipes in batch
+    size_t getPipesNum() const;
+
+    /// Integration step of all pipes
+    void step(double t, double dt);
+
+private:
+
+    std::vector<BrakePipe *> pipes;
+
+    /// Solver of all pipes equations, systems are padded to maximal order
+    SweepBatch  solver;
+
+    /// Interleaved right part and solution
+    std::vector<double> f;
+    std::vector<double> x;
+
+    /// Time step, solver matrix is factorized for
+    double  cached_dt;
+
+    /// Solver is to be rebuilt after pipes set change
+    bool    is_changed;
+
+    /// Rebuild and factorize solver matrix for time step
+    void updateMatrix(double dt);
+};
+
+#endif // PIPE_BATCH_H
@@ -0,0 +1,85 @@
+//------------------------------------------------------------------------------
+//
+//      Batched sweep method for independent tridiagonal systems
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Batched sweep method for independent tridiagonal systems
+ * \copyright maisvendoo
+ */
+
+#ifndef     SWEEP_BATCH_H
+#define     SWEEP_BATCH_H
+
+#include    <QtGlobal>
+
+#include    <vector>
+
+#if defined(BRAKEPIPE_LIB)
+    #define SWEEP_BATCH_EXPORT  Q_DECL_EXPORT
+#else
+    #define SWEEP_BATCH_EXPORT  Q_DECL_IMPORT
+#endif
+
+/*!
+ * \class
+ * \brief Solver of m independent tridiagonal systems of order n
+ *
+ * Arrays are interleaved: element of row i of system k has index i * m + k,
+ * so every elimination step runs over m contiguous values. Shorter systems
+ * are padded by identity rows. Matrix is factorized once and kept, right
+ * part is not changed by solution
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class SWEEP_BATCH_EXPORT SweepBatch
+{
+public:
+
+    SweepBatch();
+
+    ~SweepBatch();
+
+    /// Set systems order and number. All rows are reset to identity
+    void resize(size_t n, size_t m);
+
+    /// Systems order
+    size_t getOrder() const;
+
+    /// Number of systems
+    size_t getSystemsNum() const;
+
+    /// Set row i of system k: a - bottom, b - top, c - main diagonal
+    void setRow(size_t k, size_t i, double a, double b, double c);
+
+    /// Forward elimination of matrices
+    void factor();
+
+    /// Solve all systems with interleaved right part f and solution x
+    void solve(const double *f, double *x);
+
+private:
+
+    size_t  n;
+    size_t  m;
+
+    /// Bottom, top and main diagonals
+    std::vector<double> A;
+    std::vector<double> B;
+    std::vector<double> C;
+
+    /// Elimination multipliers
+    std::vector<double> M;
+    /// Eliminated main diagonal
+    std::vector<double> D;
+    /// Eliminated right part
+    std::vector<double> g;
+
+    /// Solution of single system
+    void solveSingle(const double *f, double *x);
+};
+
+#endif // SWEEP_BATCH_H
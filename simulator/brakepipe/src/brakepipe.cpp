@@ -15,12 +15,24 @@
 
 #include "brakepipe.h"
 #include "CfgReader.h"
-#include "sweep.h"
+
+#include <algorithm>
 
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
 BrakePipe::BrakePipe()
+    : N(0)
+    , nodes_per_meter(0.0)
+    , is_adaptive(false)
+    , refine_factor(4.0)
+    , adapt_interval(0.1)
+    , adapt_time(0.0)
+    , is_tap_grid(true)
+    , taps_num(0)
+    , cached_dt(0.0)
+    , cached_p0(0.0)
+    , is_leak_valid(false)
 {
 
 }
@@ -39,6 +51,8 @@ BrakePipe::~BrakePipe()
 void BrakePipe::setLength(double L)
 {
     this->L = L;
+
+    leak_factor.clear();
 }
 
 //------------------------------------------------------------------------------
@@ -46,20 +60,10 @@ void BrakePipe::setLength(double L)
 //------------------------------------------------------------------------------
 void BrakePipe::setNodesNum(size_t N)
 {
-    // Set nodes count
-    this->N = N;
-
-    // Share memory
-    p.resize(N + 2);
-    V.resize(N + 2);
+    taps_num = N;
 
-    A.resize(N + 1);
-    B.resize(N + 1);
-    C.resize(N + 1);
-    f.resize(N + 1);
-
-    // Set length step
-    h = L / (N + 1);
+    // Node per vehicle, until other grid is configured
+    resizeGrid(N);
 }
 
 //------------------------------------------------------------------------------
@@ -75,7 +79,10 @@ void BrakePipe::setBeginPressure(double p0)
 //------------------------------------------------------------------------------
 void BrakePipe::setAuxRate(size_t i, double auxRate)
 {
-    V[i] = auxRate;
+    if (is_tap_grid)
+        V[i] = auxRate;
+    else
+        tap_rate[i] = auxRate;
 }
 
 //------------------------------------------------------------------------------
@@ -87,29 +94,21 @@ bool BrakePipe::step(double t, double dt)
 
     // Implicit method of parabolic PDE solution
 
-    // Calculation of coefficients
-    for (size_t i = 0; i < N; i++)
+    // Matrix depends on geometry and dt only, so it is rebuilt and
+    // factorized only if something is changed
+    if (prepare(dt) || (dt != cached_dt))
     {
-        A[i] = -c0 / h / h;
-        B[i] = A[i];
-
-        C[i] = 1 / dt + 2 * c0 / h / h;
+        solver.resize(N + 1, 1);
+        setMatrix(solver, 0, dt);
+        solver.factor();
 
-        f[i] = -Q(i) - V[i + 1] + p[i + 1] / dt;
+        cached_dt = dt;
     }
 
-    A[0] = 0;
-    A[N] = -c0 / h / h;
-
-    B[N] = 0;
-
-    C[N] = 1 / dt + c0 / h / h;
-
-    f[0] += c0 * p[0] / h / h;
-    f[N] = -Q(N) - V[N] + p[N] / dt;
+    setRightPart(f.data(), 1, dt);
 
     // Linear equation system solution
-    sweep(N + 1, A.data(), B.data(), C.data(), f.data(), p.data() + 1);
+    solver.solve(f.data(), p.data() + 1);
 
     return true;
 }
@@ -129,11 +128,34 @@ bool BrakePipe::init(QString cfg_path)
     c0 = Physics::c * Physics::c /2 / a;
     a1 = 0.1265*muf*muf*lambda / pow(d, 5);
 
+    // Grid, independent from vehicles
+    is_tap_grid = (nodes_per_meter <= 0) && !is_adaptive;
+
+    if (!is_tap_grid)
+    {
+        size_t nodes_num = taps_num;
+
+        if (nodes_per_meter > 0)
+        {
+            size_t cells = static_cast<size_t>(ceil(L * nodes_per_meter));
+            nodes_num = std::max(cells, static_cast<size_t>(2)) - 1;
+        }
+
+        resizeGrid(nodes_num);
+
+        tap_rate.assign(taps_num + 2, 0.0);
+        updateTaps();
+    }
+
+    adapt_time = 0.0;
+    p_adapt.clear();
+
+    leak_factor.clear();
+
     // Initial pressure distribution
     for (size_t i = 1; i < N + 1; i++)
     {
-        double x = i*h;
-        p[i] = p[0]*exp(-a1*(pow(L, 3) - pow(L - x, 3)));
+        p[i] = p[0]*exp(-a1*(pow(L, 3) - pow(L - x[i], 3)));
 
         if (p[i] < Physics::pA) p[i] = Physics::pA;
 
@@ -154,7 +176,16 @@ bool BrakePipe::init(QString cfg_path)
 //------------------------------------------------------------------------------
 double BrakePipe::getPressure(size_t i)
 {
-    double press = (p[i] - Physics::pA) / Physics::MPa;
+    double pi = p[i];
+
+    // Pressure at vehicle is interpolated between grid nodes
+    if (!is_tap_grid)
+    {
+        size_t j = tap_cell[i];
+        pi = p[j] + tap_weight[i] * (p[j + 1] - p[j]);
+    }
+
+    double press = (pi - Physics::pA) / Physics::MPa;
 
     if (press < 0)
         press = 0;
@@ -162,14 +193,349 @@ double BrakePipe::getPressure(size_t i)
     return press;
 }
 
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+size_t BrakePipe::getGridNodesNum() const
+{
+    return N;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+size_t BrakePipe::getOrder() const
+{
+    return N + 1;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool BrakePipe::prepare(double dt)
+{
+    bool is_geometry_changed = false;
+
+    if (is_adaptive)
+    {
+        adapt_time += dt;
+
+        if (adapt_time >= adapt_interval)
+        {
+            adapt_time = 0.0;
+            adaptGrid();
+        }
+    }
+
+    if (!is_tap_grid)
+        updateRates();
+
+    // Leak depends on geometry and p[0] only
+    if (leak_factor.size() != N + 1)
+    {
+        updateLeakFactors();
+        is_geometry_changed = true;
+    }
+
+    if (!is_leak_valid || (p[0] != cached_p0))
+    {
+        for (size_t i = 0; i <= N; i++)
+            leak[i] = Q(i);
+
+        cached_p0 = p[0];
+        is_leak_valid = true;
+    }
+
+    return is_geometry_changed;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void BrakePipe::setMatrix(SweepBatch &batch, size_t k, double dt) const
+{
+    // Node i + 1 with steps hm to left and hp to right neighbour
+    for (size_t i = 0; i < N; i++)
+    {
+        double hm = dx[i];
+        double hp = dx[i + 1];
+
+        double A = -2 * c0 / (hm + hp) / hm;
+        double B = -2 * c0 / (hm + hp) / hp;
+        double C = 1 / dt - (A + B);
+
+        batch.setRow(k, i, (i == 0) ? 0 : A, B, C);
+    }
+
+    double A = -c0 / dx[N] / dx[N];
+
+    batch.setRow(k, N, A, 0, 1 / dt - A);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void BrakePipe::setRightPart(double *f, size_t stride, double dt) const
+{
+    for (size_t i = 0; i < N; i++)
+    {
+        f[i * stride] = -leak[i] - V[i + 1] + p[i + 1] / dt;
+    }
+
+    if (N > 0)
+        f[0] += 2 * c0 / (dx[0] + dx[1]) / dx[0] * p[0];
+
+    // Node per vehicle keeps previous scheme, which takes end node terms
+    // from node N, so results of existing consists are not changed
+    size_t end = is_tap_grid ? N : N + 1;
+
+    f[N * stride] = -leak[N] - V[end] + p[end] / dt;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void BrakePipe::setSolution(const double *x, size_t stride)
+{
+    for (size_t i = 0; i <= N; i++)
+        p[i + 1] = x[i * stride];
+}
+
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
 double BrakePipe::Q(size_t i)
 {
-    double x = i*h;
+    return p[0] * leak_factor[i];
+}
 
-    return c0*a1*p[0]*( 9*a1*pow(L - x, 4) + 6*(L - x) ) * exp( -a1*(pow(L, 3) - pow(L - x, 3) ) );
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void BrakePipe::updateLeakFactors()
+{
+    leak_factor.resize(N + 1);
+    leak.resize(N + 1);
+
+    // Equation i is written for node i + 1. Node per vehicle keeps
+    // previous scheme, which takes leak at node i
+    size_t shift = is_tap_grid ? 0 : 1;
+
+    for (size_t i = 0; i <= N; i++)
+    {
+        double xi = x[i + shift];
+
+        leak_factor[i] = c0*a1*( 9*a1*pow(L - xi, 4) + 6*(L - xi) ) * exp( -a1*(pow(L, 3) - pow(L - xi, 3) ) );
+    }
+
+    // Force recalculation of leak
+    is_leak_valid = false;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void BrakePipe::resizeGrid(size_t N)
+{
+    this->N = N;
+
+    // Share memory
+    p.resize(N + 2);
+    V.resize(N + 2);
+
+    f.resize(N + 1);
+
+    x.resize(N + 2);
+    dx.resize(N + 1);
+
+    // Set length step
+    double h = L / (N + 1);
+
+    for (size_t i = 0; i <= N; i++)
+    {
+        x[i] = i * h;
+        dx[i] = h;
+    }
+
+    x[N + 1] = L;
+
+    // Geometry is changed, cached terms are recalculated on next step
+    leak_factor.clear();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void BrakePipe::updateTaps()
+{
+    // Vehicles are placed uniformly, begin and end of pipe are taps 0
+    // and taps_num + 1
+    double ht = L / (taps_num + 1);
+
+    tap_cell.resize(taps_num + 2);
+    tap_weight.resize(taps_num + 2);
+
+    size_t j = 0;
+
+    for (size_t i = 0; i <= taps_num + 1; i++)
+    {
+        double xt = (i == taps_num + 1) ? L : i * ht;
+
+        while ( (j < N) && (x[j + 1] < xt) )
+            j++;
+
+        tap_cell[i] = j;
+        tap_weight[i] = std::min(std::max((xt - x[j]) / dx[j], 0.0), 1.0);
+    }
+
+    // Vehicle's flow is spread over volume of nodes (half of steps to
+    // neighbours), so total flow doesn't depend on grid
+    node_scale.resize(N + 2);
+
+    for (size_t j = 0; j <= N + 1; j++)
+    {
+        double len = 0.5 * ( ((j > 0) ? dx[j - 1] : 0) + ((j <= N) ? dx[j] : 0) );
+        node_scale[j] = ht / len;
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void BrakePipe::updateRates()
+{
+    std::fill(V.begin(), V.end(), 0.0);
+
+    for (size_t i = 1; i <= taps_num; i++)
+    {
+        size_t j = tap_cell[i];
+        double w = tap_weight[i];
+
+        V[j] += (1 - w) * tap_rate[i] * node_scale[j];
+        V[j + 1] += w * tap_rate[i] * node_scale[j + 1];
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool BrakePipe::adaptGrid()
+{
+    size_t cells = N + 1;
+
+    if (p_adapt.size() != p.size())
+    {
+        p_adapt = p;
+        return false;
+    }
+
+    // Front is where pressure changes fast, not where gradient is high:
+    // quasi-steady pipe discharge has maximal gradient at begin all time.
+    // Nodes density is 1 far from fronts and refine_factor at fastest one
+    std::vector<double> w(cells);
+    double rate_max = 0;
+
+    for (size_t c = 0; c < cells; c++)
+    {
+        w[c] = 0.5 * ( fabs(p[c] - p_adapt[c]) + fabs(p[c + 1] - p_adapt[c + 1]) );
+        rate_max = std::max(rate_max, w[c]);
+    }
+
+    for (size_t c = 0; c < cells; c++)
+    {
+        w[c] = (rate_max > 0) ? 1 + (refine_factor - 1) * w[c] / rate_max : 1.0;
+    }
+
+    // Smoothing, so neighbour steps differ not much
+    for (int pass = 0; pass < 2; pass++)
+    {
+        std::vector<double> ws(w);
+
+        for (size_t c = 0; c < cells; c++)
+        {
+            double wl = (c > 0) ? w[c - 1] : w[c];
+            double wr = (c + 1 < cells) ? w[c + 1] : w[c];
+
+            ws[c] = 0.25 * wl + 0.5 * w[c] + 0.25 * wr;
+        }
+
+        w.swap(ws);
+    }
+
+    // New nodes equidistribute integral of density
+    double total = 0;
+
+    for (size_t c = 0; c < cells; c++)
+        total += w[c] * dx[c];
+
+    std::vector<double> new_x(N + 2);
+    new_x[0] = 0;
+    new_x[N + 1] = L;
+
+    size_t c = 0;
+    double W = 0;
+    double shift = 0;
+
+    for (size_t k = 1; k <= N; k++)
+    {
+        double target = total * k / cells;
+
+        while ( (c + 1 < cells) && (W + w[c] * dx[c] < target) )
+        {
+            W += w[c] * dx[c];
+            c++;
+        }
+
+        new_x[k] = std::min(x[c] + (target - W) / w[c], x[c + 1]);
+        shift = std::max(shift, fabs(new_x[k] - x[k]));
+    }
+
+    // Small moves aren't worth of interpolation error and refactoring
+    if (shift < 0.1 * L / cells)
+    {
+        p_adapt = p;
+        return false;
+    }
+
+    // Pressures interpolation onto new grid. Linear one smears profile on
+    // every adaptation, so monotone cubic Hermite one is used
+    std::vector<double> new_p(p);
+    size_t j = 0;
+
+    for (size_t k = 1; k <= N; k++)
+    {
+        while ( (j < N) && (x[j + 1] < new_x[k]) )
+            j++;
+
+        double s0 = (p[j + 1] - p[j]) / dx[j];
+        double sl = (j > 0) ? (p[j] - p[j - 1]) / dx[j - 1] : s0;
+        double sr = (j < N) ? (p[j + 2] - p[j + 1]) / dx[j + 1] : s0;
+
+        // Harmonic mean of slopes, zero at extremum
+        double m0 = (sl * s0 > 0) ? 2 / (1 / sl + 1 / s0) : 0;
+        double m1 = (sr * s0 > 0) ? 2 / (1 / sr + 1 / s0) : 0;
+
+        double t = (new_x[k] - x[j]) / dx[j];
+        double t2 = t * t;
+        double t3 = t2 * t;
+
+        new_p[k] = (2*t3 - 3*t2 + 1) * p[j] + (t3 - 2*t2 + t) * dx[j] * m0 +
+                   (3*t2 - 2*t3) * p[j + 1] + (t3 - t2) * dx[j] * m1;
+    }
+
+    x.swap(new_x);
+    p.swap(new_p);
+
+    p_adapt = p;
+
+    for (size_t i = 0; i <= N; i++)
+        dx[i] = x[i + 1] - x[i];
+
+    updateTaps();
+
+    leak_factor.clear();
+
+    return true;
 }
 
 //------------------------------------------------------------------------------
@@ -204,6 +570,26 @@ bool BrakePipe::loadCfg(QString cfg_path)
         }
 
         T = 273 + t;
+
+        if (!cfg.getDouble("BrakePipe", "NodesPerMeter", nodes_per_meter))
+        {
+            nodes_per_meter = 0.0;
+        }
+
+        if (!cfg.getBool("BrakePipe", "AdaptiveGrid", is_adaptive))
+        {
+            is_adaptive = false;
+        }
+
+        if (!cfg.getDouble("BrakePipe", "AdaptiveGridRefine", refine_factor))
+        {
+            refine_factor = 4.0;
+        }
+
+        if (!cfg.getDouble("BrakePipe", "AdaptiveGridInterval", adapt_interval))
+        {
+            adapt_interval = 0.1;
+        }
     }
     else
     {
@@ -211,7 +597,14 @@ bool BrakePipe::loadCfg(QString cfg_path)
         d = 0.0343;
         muf = 1.5e-8;
         T = 293;
+
+        nodes_per_meter = 0.0;
+        is_adaptive = false;
+        refine_factor = 4.0;
+        adapt_interval = 0.1;
     }
 
+    refine_factor = std::max(refine_factor, 1.0);
+
     return true;
 }
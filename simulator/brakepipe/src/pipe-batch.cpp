@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+//
+//      Batch of brakepipes solved together
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Batch of brakepipes solved together
+ * \copyright maisvendoo
+ */
+
+#include    "pipe-batch.h"
+
+#include    <algorithm>
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+PipeBatch::PipeBatch()
+    : cached_dt(0.0)
+    , is_changed(true)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+PipeBatch::~PipeBatch()
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void PipeBatch::addPipe(BrakePipe *pipe)
+{
+    if (pipe == nullptr)
+        return;
+
+    pipes.push_back(pipe);
+    is_changed = true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+size_t PipeBatch::getPipesNum() const
+{
+    return pipes.size();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void PipeBatch::step(double t, double dt)
+{
+    Q_UNUSED(t)
+
+    if (pipes.empty())
+        return;
+
+    // Every pipe must update its grid and leak, so all of them are prepared
+    bool is_geometry_changed = false;
+
+    for (auto pipe : pipes)
+        is_geometry_changed = pipe->prepare(dt) || is_geometry_changed;
+
+    if (is_changed || is_geometry_changed || (dt != cached_dt))
+        updateMatrix(dt);
+
+    size_t m = pipes.size();
+
+    for (size_t k = 0; k < m; k++)
+        pipes[k]->setRightPart(f.data() + k, m, dt);
+
+    solver.solve(f.data(), x.data());
+
+    for (size_t k = 0; k < m; k++)
+        pipes[k]->setSolution(x.data() + k, m);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void PipeBatch::updateMatrix(double dt)
+{
+    size_t n = 0;
+    size_t m = pipes.size();
+
+    for (auto pipe : pipes)
+        n = std::max(n, pipe->getOrder());
+
+    // Padding rows are identity ones with zero right part
+    solver.resize(n, m);
+    f.assign(n * m, 0.0);
+    x.assign(n * m, 0.0);
+
+    for (size_t k = 0; k < m; k++)
+        pipes[k]->setMatrix(solver, k, dt);
+
+    solver.factor();
+
+    cached_dt = dt;
+    is_changed = false;
+}
@@ -0,0 +1,171 @@
+//------------------------------------------------------------------------------
+//
+//      Batched sweep method for independent tridiagonal systems
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Batched sweep method for independent tridiagonal systems
+ * \copyright maisvendoo
+ */
+
+#include    "sweep-batch.h"
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+SweepBatch::SweepBatch()
+    : n(0)
+    , m(0)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+SweepBatch::~SweepBatch()
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void SweepBatch::resize(size_t n, size_t m)
+{
+    this->n = n;
+    this->m = m;
+
+    A.assign(n * m, 0.0);
+    B.assign(n * m, 0.0);
+    C.assign(n * m, 1.0);
+
+    M.assign(n * m, 0.0);
+    D.assign(n * m, 1.0);
+    g.assign(n * m, 0.0);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+size_t SweepBatch::getOrder() const
+{
+    return n;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+size_t SweepBatch::getSystemsNum() const
+{
+    return m;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void SweepBatch::setRow(size_t k, size_t i, double a, double b, double c)
+{
+    size_t j = i * m + k;
+
+    A[j] = a;
+    B[j] = b;
+    C[j] = c;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void SweepBatch::factor()
+{
+    if (n == 0)
+        return;
+
+    for (size_t k = 0; k < m; k++)
+        D[k] = C[k];
+
+    for (size_t i = 1; i < n; i++)
+    {
+        const double *a = A.data() + i * m;
+        const double *b_prev = B.data() + (i - 1) * m;
+        const double *c = C.data() + i * m;
+        const double *d_prev = D.data() + (i - 1) * m;
+        double *mul = M.data() + i * m;
+        double *d = D.data() + i * m;
+
+        for (size_t k = 0; k < m; k++)
+        {
+            mul[k] = a[k] / d_prev[k];
+            d[k] = c[k] - mul[k] * b_prev[k];
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void SweepBatch::solve(const double *f, double *x)
+{
+    if (n == 0)
+        return;
+
+    if (m == 1)
+    {
+        solveSingle(f, x);
+        return;
+    }
+
+    // Forward substitution
+    for (size_t k = 0; k < m; k++)
+        g[k] = f[k];
+
+    for (size_t i = 1; i < n; i++)
+    {
+        const double *mul = M.data() + i * m;
+        const double *f_i = f + i * m;
+        const double *g_prev = g.data() + (i - 1) * m;
+        double *g_i = g.data() + i * m;
+
+        for (size_t k = 0; k < m; k++)
+            g_i[k] = f_i[k] - mul[k] * g_prev[k];
+    }
+
+    // Back substitution
+    const double *g_last = g.data() + (n - 1) * m;
+    const double *d_last = D.data() + (n - 1) * m;
+    double *x_last = x + (n - 1) * m;
+
+    for (size_t k = 0; k < m; k++)
+        x_last[k] = g_last[k] / d_last[k];
+
+    for (size_t i = n - 1; i-- > 0; )
+    {
+        const double *b = B.data() + i * m;
+        const double *d = D.data() + i * m;
+        const double *g_i = g.data() + i * m;
+        const double *x_next = x + (i + 1) * m;
+        double *x_i = x + i * m;
+
+        for (size_t k = 0; k < m; k++)
+            x_i[k] = (g_i[k] - b[k] * x_next[k]) / d[k];
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void SweepBatch::solveSingle(const double *f, double *x)
+{
+    // Inner loops over one system only cost more than substitution itself
+    g[0] = f[0];
+
+    for (size_t i = 1; i < n; i++)
+        g[i] = f[i] - M[i] * g[i - 1];
+
+    x[n - 1] = g[n - 1] / D[n - 1];
+
+    for (size_t i = n - 1; i-- > 0; )
+        x[i] = (g[i] - B[i] * x[i + 1]) / D[i];
+}
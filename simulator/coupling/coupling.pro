@@ -15,18 +15,21 @@ CONFIG(debug, debug|release) {
     LIBS += -L../../../lib -lCfgReader_d
     LIBS += -L../../../lib -lphysics_d
     LIBS += -L../../../lib -lJournal_d
+    LIBS += -L../../../lib -lplugin-loader_d
 
 } else {
 
     LIBS += -L../../../lib -lCfgReader
     LIBS += -L../../../lib -lphysics
     LIBS += -L../../../lib -lJournal
+    LIBS += -L../../../lib -lplugin-loader
 }
 
 INCLUDEPATH += ./include
 INCLUDEPATH += ../physics/include
 INCLUDEPATH += ../../CfgReader/include
 INCLUDEPATH += ../../libJournal/include
+INCLUDEPATH += ../../plugin-loader/include
 
 HEADERS += $$files(./include/*.h)
 SOURCES += $$files(./src/*.cpp)
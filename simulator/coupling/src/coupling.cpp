@@ -15,7 +15,7 @@
 
 #include    "coupling.h"
 
-#include    <QLibrary>
+#include    "module-registry.h"
 
 #include    "CfgReader.h"
 #include    "Journal.h"
@@ -84,24 +84,11 @@ Coupling *loadCoupling(QString lib_path)
 {
     Coupling *coupling = nullptr;
 
-    QLibrary lib(lib_path);
+    GetCoupling getCoupling = ModuleRegistry::instance()->resolve<GetCoupling>(lib_path, "getCoupling");
 
-    if (lib.load())
+    if (getCoupling)
     {
-        GetCoupling getCoupling = reinterpret_cast<GetCoupling>(lib.resolve("getCoupling"));
-
-        if (getCoupling)
-        {
-            coupling = getCoupling();
-        }
-        else
-        {
-            Journal::instance()->error(lib.errorString());
-        }
-    }
-    else
-    {
-        Journal::instance()->error(lib.errorString());
+        coupling = getCoupling();
     }
 
     return coupling;
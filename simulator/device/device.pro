@@ -18,6 +18,7 @@ CONFIG(debug, debug|release) {
     LIBS += -L../../../lib -lphysics_d
     LIBS += -L../../../lib -lfilesystem_d
     LIBS += -L../../../lib -lJournal_d
+    LIBS += -L../../../lib -lplugin-loader_d
 
 } else {
 
@@ -25,6 +26,7 @@ CONFIG(debug, debug|release) {
     LIBS += -L../../../lib -lphysics    
     LIBS += -L../../../lib -lfilesystem
     LIBS += -L../../../lib -lJournal
+    LIBS += -L../../../lib -lplugin-loader
 }
 
 INCLUDEPATH += ./include
@@ -33,6 +35,7 @@ INCLUDEPATH += ../solver/include
 INCLUDEPATH += ../../CfgReader/include
 INCLUDEPATH += ../../filesystem/include
 INCLUDEPATH += ../../libJournal/include
+INCLUDEPATH += ../../plugin-loader/include
 INCLUDEPATH += ../../common-headers/include
 
 
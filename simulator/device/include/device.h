@@ -18,7 +18,6 @@
 #include    "device-export.h"
 
 #include    <QObject>
-#include    <QMap>
 
 #include    "solver-types.h"
 #include    "physics.h"
@@ -27,6 +26,7 @@
 #include    "control-signals.h"
 #include    "feedback-signals.h"
 #include    "key-symbols.h"
+#include    "keys-state.h"
 #include    "timer.h"
 #include    "trigger.h"
 
@@ -66,8 +66,8 @@ public:
 
     QString getDebugMsg() const;
 
-    ///
-    void setControl(QMap<int, bool> keys,
+    /// Set keyboard state view and external control signals
+    void setControl(const KeysState *keys,
                     control_signals_t control_signals = control_signals_t());
 
     ///
@@ -109,7 +109,8 @@ protected:
 
     QString     DebugMsg;
 
-    QMap<int, bool>     keys;
+    /// Keyboard state, shared by all devices of vehicle
+    const KeysState     *keys;
     control_signals_t   control_signals;
 
     feedback_signals_t  feedback;
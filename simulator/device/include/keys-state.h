@@ -0,0 +1,93 @@
+//------------------------------------------------------------------------------
+//
+//      Keyboard state snapshot
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Keyboard state snapshot
+ * \copyright maisvendoo
+ */
+
+#ifndef     KEYS_STATE_H
+#define     KEYS_STATE_H
+
+#include    <QtGlobal>
+#include    <array>
+
+/*!
+ * \class
+ * \brief Bitset of pressed keys
+ *
+ * Snapshot is updated by model between integration steps. Vehicles and
+ * devices hold pointer to the same snapshot and only read it
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class KeysState
+{
+public:
+
+    /// Number of key codes
+    static const size_t KEYS_NUM = 0x10000;
+
+    /// Number of 64-bit words
+    static const size_t WORDS_NUM = KEYS_NUM / 64;
+
+    KeysState()
+    {
+        clear();
+    }
+
+    /// Get key state
+    bool getKeyState(int key) const
+    {
+        size_t code = static_cast<size_t>(static_cast<unsigned>(key));
+
+        if (code >= KEYS_NUM)
+            return false;
+
+        return (bits[code / 64] >> (code % 64)) & 1;
+    }
+
+    /// Set key state
+    void setKeyState(int key, bool state)
+    {
+        size_t code = static_cast<size_t>(static_cast<unsigned>(key));
+
+        if (code >= KEYS_NUM)
+            return;
+
+        quint64 bit = static_cast<quint64>(1) << (code % 64);
+
+        if (state)
+            bits[code / 64] |= bit;
+        else
+            bits[code / 64] &= ~bit;
+    }
+
+    /// Release all keys
+    void clear()
+    {
+        bits.fill(0);
+    }
+
+    /// Bitset words
+    quint64 *data()
+    {
+        return bits.data();
+    }
+
+    const quint64 *data() const
+    {
+        return bits.data();
+    }
+
+private:
+
+    std::array<quint64, WORDS_NUM> bits;
+};
+
+#endif // KEYS_STATE_H
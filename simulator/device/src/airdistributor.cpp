@@ -1,6 +1,6 @@
 #include    "airdistributor.h"
 
-#include    <QLibrary>
+#include    "module-registry.h"
 
 //------------------------------------------------------------------------------
 //
@@ -76,16 +76,11 @@ AirDistributor *loadAirDistributor(QString lib_path)
 {
     AirDistributor *airdist = nullptr;
 
-    QLibrary lib(lib_path);
+    GetAirDistributor getAirDistributor = ModuleRegistry::instance()->resolve<GetAirDistributor>(lib_path, "getAirDistributor");
 
-    if (lib.load())
+    if (getAirDistributor)
     {
-        GetAirDistributor getAirDistributor = reinterpret_cast<GetAirDistributor>(lib.resolve("getAirDistributor"));
-
-        if (getAirDistributor)
-        {
-            airdist = getAirDistributor();
-        }
+        airdist = getAirDistributor();
     }
 
     return airdist;
@@ -1,6 +1,6 @@
 #include    "automatic-train-stop.h"
 
-#include    <QLibrary>
+#include    "module-registry.h"
 
 //------------------------------------------------------------------------------
 //
@@ -69,16 +69,11 @@ AutoTrainStop *loadAutoTrainStop(QString lib_path)
 {
     AutoTrainStop *autostop = nullptr;
 
-    QLibrary lib(lib_path);
+    GetAutoTrainStop getAutoTrainStop = ModuleRegistry::instance()->resolve<GetAutoTrainStop>(lib_path, "getAutoTrainStop");
 
-    if (lib.load())
+    if (getAutoTrainStop)
     {
-        GetAutoTrainStop getAutoTrainStop = reinterpret_cast<GetAutoTrainStop>(lib.resolve("getAutoTrainStop"));
-
-        if (getAutoTrainStop)
-        {
-            autostop = getAutoTrainStop();
-        }
+        autostop = getAutoTrainStop();
     }
 
     return autostop;
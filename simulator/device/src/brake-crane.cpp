@@ -1,6 +1,6 @@
 #include    "brake-crane.h"
 
-#include    <QLibrary>
+#include    "module-registry.h"
 
 //------------------------------------------------------------------------------
 //
@@ -104,16 +104,11 @@ BrakeCrane *loadBrakeCrane(QString lib_path)
 {
     BrakeCrane *crane = nullptr;
 
-    QLibrary lib(lib_path);
+    GetBrakeCrane getBrakeCrane = ModuleRegistry::instance()->resolve<GetBrakeCrane>(lib_path, "getBrakeCrane");
 
-    if (lib.load())
+    if (getBrakeCrane)
     {
-        GetBrakeCrane getBrakeCrane = reinterpret_cast<GetBrakeCrane>(lib.resolve("getBrakeCrane"));
-
-        if (getBrakeCrane)
-        {
-            crane = getBrakeCrane();
-        }
+        crane = getBrakeCrane();
     }
 
     return crane;
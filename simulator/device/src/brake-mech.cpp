@@ -14,7 +14,7 @@
 
 #include    "brake-mech.h"
 
-#include    <QLibrary>
+#include    "module-registry.h"
 
 //------------------------------------------------------------------------------
 //
@@ -195,16 +195,11 @@ BrakeMech *loadBrakeMech(QString lib_path)
 {
     BrakeMech *brake_mech = nullptr;
 
-    QLibrary lib(lib_path);
+    GetBrakeMech getBrakeMech = ModuleRegistry::instance()->resolve<GetBrakeMech>(lib_path, "getBrakeMech");
 
-    if (lib.load())
+    if (getBrakeMech)
     {
-        GetBrakeMech getBrakeMech = reinterpret_cast<GetBrakeMech>(lib.resolve("getBrakeMech"));
-
-        if (getBrakeMech)
-        {
-            brake_mech = getBrakeMech();
-        }
+        brake_mech = getBrakeMech();
     }
 
     return brake_mech;
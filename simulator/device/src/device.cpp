@@ -21,6 +21,7 @@
 //
 //------------------------------------------------------------------------------
 Device::Device(QObject *parent) : QObject(parent)
+  , keys(Q_NULLPTR)
 {
     FileSystem &fs = FileSystem::getInstance();
     cfg_dir = fs.getDevicesDir();
@@ -179,10 +180,10 @@ QString Device::getDebugMsg() const
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
-void Device::setControl(QMap<int, bool> keys,
+void Device::setControl(const KeysState *keys,
                         control_signals_t control_signals)
 {
-    this->keys = QMap<int, bool>(keys);
+    this->keys = keys;
     this->control_signals = control_signals;
 }
 
@@ -276,15 +277,10 @@ void Device::stepDiscrete(double t, double dt)
 //------------------------------------------------------------------------------
 bool Device::getKeyState(int key) const
 {
-    if (keys.size() == 0)
+    if (keys == Q_NULLPTR)
         return false;
 
-    auto it = keys.find(key);
-
-    if ( it != keys.end() )
-        return it.value();
-
-    return false;
+    return keys->getKeyState(key);
 }
 
 //------------------------------------------------------------------------------
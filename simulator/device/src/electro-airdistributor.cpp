@@ -1,6 +1,6 @@
 #include    "electro-airdistributor.h"
 
-#include    <QLibrary>
+#include    "module-registry.h"
 
 //------------------------------------------------------------------------------
 //
@@ -72,16 +72,11 @@ ElectroAirDistributor *loadElectroAirDistributor(QString lib_path)
 
         ElectroAirDistributor *electro_airdist = nullptr;
 
-        QLibrary lib(lib_path);
+        GetElectroAirDistributor getElectroAirDistributor = ModuleRegistry::instance()->resolve<GetElectroAirDistributor>(lib_path, "getElectroAirDistributor");
 
-        if (lib.load())
+        if (getElectroAirDistributor)
         {
-            GetElectroAirDistributor getElectroAirDistributor = reinterpret_cast<GetElectroAirDistributor>(lib.resolve("getElectroAirDistributor"));
-
-            if (getElectroAirDistributor)
-            {
-                electro_airdist = getElectroAirDistributor();
-            }
+            electro_airdist = getElectroAirDistributor();
         }
 
         return electro_airdist;
@@ -1,6 +1,6 @@
 #include    "loco-crane.h"
 
-#include    <QLibrary>
+#include    "module-registry.h"
 
 //------------------------------------------------------------------------------
 //
@@ -95,16 +95,11 @@ LocoCrane *loadLocoCrane(QString lib_path)
 {
     LocoCrane *crane = nullptr;
 
-    QLibrary lib(lib_path);
+    GetLocoCrane getLocoCrane = ModuleRegistry::instance()->resolve<GetLocoCrane>(lib_path, "getLocoCrane");
 
-    if (lib.load())
+    if (getLocoCrane)
     {
-        GetLocoCrane getLocoCrane = reinterpret_cast<GetLocoCrane>(lib.resolve("getLocoCrane"));
-
-        if (getLocoCrane)
-        {
-            crane = getLocoCrane();
-        }
+        crane = getLocoCrane();
     }
 
     return crane;
@@ -1,6 +1,6 @@
 #include    "traction-controller.h"
 
-#include    <QLibrary>
+#include    "module-registry.h"
 
 //------------------------------------------------------------------------------
 //
@@ -25,16 +25,11 @@ TractionController *loadTractionController(QString lib_path)
 {
     TractionController *controller = nullptr;
 
-    QLibrary lib(lib_path);
+    GetTractionController getTractionController = ModuleRegistry::instance()->resolve<GetTractionController>(lib_path, "getTractionController");
 
-    if (lib.load())
+    if (getTractionController)
     {
-        GetTractionController getTractionController = reinterpret_cast<GetTractionController>(lib.resolve("getTractionController"));
-
-        if (getTractionController)
-        {
-            controller = getTractionController();
-        }
+        controller = getTractionController();
     }
 
     return controller;
@@ -1,6 +1,6 @@
 #include    "virtual-interface-device.h"
 
-#include    <QLibrary>
+#include    "module-registry.h"
 
 //------------------------------------------------------------------------------
 //
@@ -53,16 +53,11 @@ VirtualInterfaceDevice *loadInterfaceDevice(QString lib_path)
 {
     VirtualInterfaceDevice *device = nullptr;
 
-    QLibrary lib(lib_path);
+    GetInterfaceDevice getInterfaceDevice = ModuleRegistry::instance()->resolve<GetInterfaceDevice>(lib_path, "getInterfaceDevice");
 
-    if (lib.load())
+    if (getInterfaceDevice)
     {
-        GetInterfaceDevice getInterfaceDevice = reinterpret_cast<GetInterfaceDevice>(lib.resolve("getInterfaceDevice"));
-
-        if (getInterfaceDevice)
-        {
-            device = getInterfaceDevice();
-        }
+        device = getInterfaceDevice();
     }
 
     return device;
@@ -0,0 +1,143 @@
+#ifndef     DOPRI5_H
+#define     DOPRI5_H
+
+#include    "solver.h"
+
+/*!
+ *  \class
+ *  \brief Dormand-Prince 5(4) integration method
+ *
+ *  Last stage of accepted step is reused as first stage of next step
+ *  (FSAL), first stage is kept across rejected attempts. Step size is
+ *  controlled by PI-controller. Dense output of 4th order is available
+ *  inside last accepted step
+ */
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+class  DOPRI5Solver : public Solver
+{
+public:
+
+    DOPRI5Solver();
+    ~DOPRI5Solver();
+
+    /// Method step
+    bool step(OdeSystem *ode_sys,
+              state_vector_t &Y,
+              state_vector_t &dYdt,
+              double t,
+              double &dt,
+              double max_step,
+              double local_err);
+
+    /// Dense output inside last accepted step
+    bool getDenseOutput(double t, state_vector_t &Y);
+
+protected:
+
+    // Nodes
+    const double c2 = 1.0 / 5;
+    const double c3 = 3.0 / 10;
+    const double c4 = 4.0 / 5;
+    const double c5 = 8.0 / 9;
+
+    // Butcher tableau
+    const double a21 = 1.0 / 5;
+
+    const double a31 = 3.0 / 40;
+    const double a32 = 9.0 / 40;
+
+    const double a41 = 44.0 / 45;
+    const double a42 = -56.0 / 15;
+    const double a43 = 32.0 / 9;
+
+    const double a51 = 19372.0 / 6561;
+    const double a52 = -25360.0 / 2187;
+    const double a53 = 64448.0 / 6561;
+    const double a54 = -212.0 / 729;
+
+    const double a61 = 9017.0 / 3168;
+    const double a62 = -355.0 / 33;
+    const double a63 = 46732.0 / 5247;
+    const double a64 = 49.0 / 176;
+    const double a65 = -5103.0 / 18656;
+
+    const double a71 = 35.0 / 384;
+    const double a73 = 500.0 / 1113;
+    const double a74 = 125.0 / 192;
+    const double a75 = -2187.0 / 6784;
+    const double a76 = 11.0 / 84;
+
+    // Error estimation coefficients
+    const double e1 = 71.0 / 57600;
+    const double e3 = -71.0 / 16695;
+    const double e4 = 71.0 / 1920;
+    const double e5 = -17253.0 / 339200;
+    const double e6 = 22.0 / 525;
+    const double e7 = -1.0 / 40;
+
+    // Dense output coefficients
+    const double d1 = -12715105075.0 / 11282082432.0;
+    const double d3 = 87487479700.0 / 32700410799.0;
+    const double d4 = -10690763975.0 / 1880347072.0;
+    const double d5 = 701980252875.0 / 199316789632.0;
+    const double d6 = -1453857185.0 / 822651844.0;
+    const double d7 = 69997945.0 / 29380423.0;
+
+    // PI-controller parameters
+    const double safety = 0.9;
+    const double beta = 0.04;
+    const double alpha = 0.2 - 0.75 * beta;
+    const double fac_min = 0.2;
+    const double fac_max = 10.0;
+
+    // Stages derivatives
+    state_vector_t k1;
+    state_vector_t k2;
+    state_vector_t k3;
+    state_vector_t k4;
+    state_vector_t k5;
+    state_vector_t k6;
+    state_vector_t k7;
+    state_vector_t Y1;
+    state_vector_t Ytmp;
+
+    // Dense output polynom coefficients
+    state_vector_t rcont1;
+    state_vector_t rcont2;
+    state_vector_t rcont3;
+    state_vector_t rcont4;
+    state_vector_t rcont5;
+
+    // First step flag
+    bool first_step;
+
+    // k1 is valid for next step (FSAL)
+    bool is_k1_valid;
+
+    // Dense output is valid
+    bool is_dense_valid;
+
+    // Last accepted step
+    double t_old;
+    double dt_old;
+
+    // Time at end of last accepted step
+    double t_last;
+
+    // Proposed next step and step returned to caller
+    double dt_next;
+    double dt_returned;
+
+    // Normalized error of previous accepted step
+    double err_old;
+
+    // Maximal iteraion count
+    int MAX_ITER;
+
+    /// Prepare dense output after accepted step
+    void prepareDenseOutput(const state_vector_t &Y, double t, double dt);
+};
+
+#endif // DOPRI5_H
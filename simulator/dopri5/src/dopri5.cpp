@@ -0,0 +1,232 @@
+#include    "dopri5.h"
+
+#include    <cmath>
+#include    <cstring>
+#include    <algorithm>
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+DOPRI5Solver::DOPRI5Solver()
+    : first_step(true)
+    , is_k1_valid(false)
+    , is_dense_valid(false)
+    , t_old(0.0)
+    , dt_old(0.0)
+    , t_last(0.0)
+    , dt_next(0.0)
+    , dt_returned(0.0)
+    , err_old(1e-4)
+    , MAX_ITER(100)
+{
+
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+DOPRI5Solver::~DOPRI5Solver()
+{
+
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+bool DOPRI5Solver::step(OdeSystem *ode_sys,
+                        state_vector_t &Y,
+                        state_vector_t &dYdt,
+                        double t,
+                        double &dt,
+                        double max_step,
+                        double local_err)
+{
+    size_t n = Y.size();
+
+    // Share required memory
+    if (first_step)
+    {
+        k1.resize(n);
+        k2.resize(n);
+        k3.resize(n);
+        k4.resize(n);
+        k5.resize(n);
+        k6.resize(n);
+        k7.resize(n);
+        Y1.resize(n);
+        Ytmp.resize(n);
+
+        rcont1.resize(n);
+        rcont2.resize(n);
+        rcont3.resize(n);
+        rcont4.resize(n);
+        rcont5.resize(n);
+
+        first_step = false;
+    }
+
+    // Caller returns step taken before, so use proposed one.
+    // Otherwise step was changed by caller
+    double h = dt;
+
+    if ( (dt_next > 0) && (dt == dt_returned) )
+        h = dt_next;
+
+    h = std::min(h, max_step);
+
+    // First stage is the last stage of previous step (FSAL), if state
+    // vector is not changed by caller since that step
+    bool is_fsal = is_k1_valid && (t == t_last) &&
+            (memcmp(Y.data(), Y1.data(), sizeof(double) * n) == 0);
+
+    if (!is_fsal)
+        ode_sys->calcDerivative(Y, k1, t);
+
+    const double facc1 = 1.0 / fac_min;
+    const double facc2 = 1.0 / fac_max;
+
+    int iter = 0;
+
+    do
+    {
+        // Iteration count increment
+        iter++;
+
+        for (size_t i = 0; i < n; ++i)
+            Ytmp[i] = Y[i] + h * a21 * k1[i];
+
+        ode_sys->calcDerivative(Ytmp, k2, t + c2 * h);
+
+        for (size_t i = 0; i < n; ++i)
+            Ytmp[i] = Y[i] + h * (a31 * k1[i] + a32 * k2[i]);
+
+        ode_sys->calcDerivative(Ytmp, k3, t + c3 * h);
+
+        for (size_t i = 0; i < n; ++i)
+            Ytmp[i] = Y[i] + h * (a41 * k1[i] + a42 * k2[i] + a43 * k3[i]);
+
+        ode_sys->calcDerivative(Ytmp, k4, t + c4 * h);
+
+        for (size_t i = 0; i < n; ++i)
+            Ytmp[i] = Y[i] + h * (a51 * k1[i] + a52 * k2[i] + a53 * k3[i] +
+                                  a54 * k4[i]);
+
+        ode_sys->calcDerivative(Ytmp, k5, t + c5 * h);
+
+        for (size_t i = 0; i < n; ++i)
+            Ytmp[i] = Y[i] + h * (a61 * k1[i] + a62 * k2[i] + a63 * k3[i] +
+                                  a64 * k4[i] + a65 * k5[i]);
+
+        ode_sys->calcDerivative(Ytmp, k6, t + h);
+
+        // New state vector's value
+        for (size_t i = 0; i < n; ++i)
+            Y1[i] = Y[i] + h * (a71 * k1[i] + a73 * k3[i] + a74 * k4[i] +
+                                a75 * k5[i] + a76 * k6[i]);
+
+        ode_sys->calcDerivative(Y1, k7, t + h);
+
+        // Local error calculation
+        double delta = 0;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            double eps = h * (e1 * k1[i] + e3 * k3[i] + e4 * k4[i] +
+                              e5 * k5[i] + e6 * k6[i] + e7 * k7[i]);
+
+            delta = std::max(delta, std::abs(eps));
+        }
+
+        double err = delta / local_err;
+        double fac11 = pow(err, alpha);
+
+        if (err <= 1.0)
+        {
+            // Step is accepted, PI-control of next step
+            double fac = fac11 / pow(err_old, beta);
+            fac = std::max(facc2, std::min(facc1, fac / safety));
+
+            err_old = std::max(err, 1e-4);
+
+            prepareDenseOutput(Y, t, h);
+
+            std::copy(Y1.begin(), Y1.end(), Y.begin());
+
+            // Last stage will be used as first stage on next step
+            k1.swap(k7);
+            is_k1_valid = true;
+            t_last = t + h;
+
+            std::copy(k1.begin(), k1.end(), dYdt.begin());
+
+            dt = h;
+            dt_returned = dt;
+            dt_next = std::min(h / fac, max_step);
+
+            return true;
+        }
+
+        // Step is rejected, first stage is not changed
+        h = h / std::min(facc1, fac11 / safety);
+
+    } while (iter <= MAX_ITER);
+
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+bool DOPRI5Solver::getDenseOutput(double t, state_vector_t &Y)
+{
+    if (!is_dense_valid)
+        return false;
+
+    double theta = (t - t_old) / dt_old;
+
+    if ( (theta < 0.0) || (theta > 1.0) )
+        return false;
+
+    double theta1 = 1.0 - theta;
+
+    size_t n = rcont1.size();
+    Y.resize(n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        Y[i] = rcont1[i] + theta * (rcont2[i] + theta1 * (rcont3[i] +
+               theta * (rcont4[i] + theta1 * rcont5[i])));
+    }
+
+    return true;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void DOPRI5Solver::prepareDenseOutput(const state_vector_t &Y, double t, double dt)
+{
+    size_t n = Y.size();
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        double ydiff = Y1[i] - Y[i];
+        double bspl = dt * k1[i] - ydiff;
+
+        rcont1[i] = Y[i];
+        rcont2[i] = ydiff;
+        rcont3[i] = bspl;
+        rcont4[i] = ydiff - dt * k7[i] - bspl;
+        rcont5[i] = dt * (d1 * k1[i] + d3 * k3[i] + d4 * k4[i] +
+                          d5 * k5[i] + d6 * k6[i] + d7 * k7[i]);
+    }
+
+    t_old = t;
+    dt_old = dt;
+    is_dense_valid = true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+GET_SOLVER(DOPRI5Solver)
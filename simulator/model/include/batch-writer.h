@@ -0,0 +1,146 @@
+//------------------------------------------------------------------------------
+//
+//      Signals output of batch simulation
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Signals output of batch simulation
+ * \copyright maisvendoo
+ */
+
+#ifndef     BATCH_WRITER_H
+#define     BATCH_WRITER_H
+
+#include    <QFile>
+#include    <QByteArray>
+#include    <vector>
+
+class Vehicle;
+class CfgReader;
+
+/*!
+ * \struct
+ * \brief Output signal description
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct batch_signal_t
+{
+    enum
+    {
+        SIGNAL_COORD,
+        SIGNAL_VELOCITY,
+        SIGNAL_ANALOG,
+        SIGNAL_DISCRETE,
+        SIGNAL_COUPLING_FORCE
+    };
+
+    /// Column name
+    QString name;
+    /// Vehicle index in train
+    size_t  vehicle;
+    /// Signal type
+    int     type;
+    /// Index of analog or discrete signal
+    size_t  index;
+
+    batch_signal_t()
+        : name("")
+        , vehicle(0)
+        , type(SIGNAL_COORD)
+        , index(0)
+    {
+
+    }
+};
+
+/*!
+ * \class
+ * \brief Writer of selected signals into table file
+ *
+ * Signals are configured in batch.xml:
+ *
+ * <Batch> section contains OutputFile (relative to logs directory) and
+ * OutputInterval (s). Each <Signal> section contains Name, Vehicle,
+ * Type (Coord, Velocity, Analog, Discrete, CouplingForce) and Index.
+ * Coupling force is force in coupling behind vehicle. File has one column
+ * per signal and one row per output interval, separated by semicolon.
+ * Rows are written on grid StartTime + k * OutputInterval, whatever the
+ * integration step is: signals are interpolated linearly between steps,
+ * discrete signals keep value of previous step.
+ * Without signals configuration, coordinate and velocity of first and last
+ * vehicles are written
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class BatchWriter
+{
+public:
+
+    BatchWriter();
+
+    ~BatchWriter();
+
+    /// Load configuration and open output file. Empty path means path from config
+    bool init(const QString &cfg_path,
+              const QString &output_path,
+              std::vector<Vehicle *> *vehicles);
+
+    /// Write row, if output interval is elapsed
+    void write(double t);
+
+    /// Flush and close output file
+    void close();
+
+    /// Number of written rows
+    quint64 getRowsCount() const;
+
+private:
+
+    std::vector<Vehicle *>          *vehicles;
+
+    std::vector<batch_signal_t>     signals_list;
+
+    QFile       file;
+
+    /// Row text buffer
+    QByteArray  row;
+
+    /// Output interval
+    double      interval;
+
+    /// Time of first row (grid begin)
+    double      begin_time;
+
+    /// Time of next row
+    double      next_time;
+
+    quint64     rows_count;
+
+    /// Time and signal values of previous step
+    double      prev_time;
+    std::vector<double> prev_values;
+
+    /// Signal values of current step
+    std::vector<double> values;
+
+    /// Signal values, interpolated to grid time
+    std::vector<double> grid_values;
+
+    /// Signals loading from config
+    void loadSignals(CfgReader &cfg);
+
+    /// Signals for empty config
+    void setDefaultSignals();
+
+    double getValue(const batch_signal_t &signal) const;
+
+    /// Write row of values at time t
+    void writeRow(double t, const std::vector<double> &row_values);
+};
+
+#endif // BATCH_WRITER_H
@@ -0,0 +1,84 @@
+//------------------------------------------------------------------------------
+//
+//      Timed keys events for batch simulation
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Timed keys events for batch simulation
+ * \copyright maisvendoo
+ */
+
+#ifndef     CONTROL_SCRIPT_H
+#define     CONTROL_SCRIPT_H
+
+#include    <QString>
+#include    <vector>
+
+#include    "keys-state.h"
+
+/*!
+ * \struct
+ * \brief Key press or release at given time
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct control_event_t
+{
+    /// Model time, s
+    double  time;
+    /// Key code
+    int     key;
+    /// Key is pressed
+    bool    state;
+
+    control_event_t()
+        : time(0.0)
+        , key(0)
+        , state(false)
+    {
+
+    }
+};
+
+/*!
+ * \class
+ * \brief Keyboard replacement for batch simulation
+ *
+ * Script file contains <Event> sections with Time, Key and State fields.
+ * Key is single character or numeric code from key-symbols.h (decimal or
+ * 0x-prefixed hex). So brake crane position schedule is written as
+ * sequence of key presses and releases
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class ControlScript
+{
+public:
+
+    ControlScript();
+
+    ~ControlScript();
+
+    /// Load events from file
+    bool load(const QString &path);
+
+    /// Apply events, which time has come
+    void step(double t, KeysState &keys);
+
+    /// Events number
+    size_t getEventsCount() const;
+
+private:
+
+    /// Events, sorted by time
+    std::vector<control_event_t>    events;
+
+    /// Next event to apply
+    size_t  next_event;
+};
+
+#endif // CONTROL_SCRIPT_H
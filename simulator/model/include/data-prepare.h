@@ -2,6 +2,7 @@
 #define     DATA_PREPARE_H
 
 #include    "abstract-data-engine.h"
+#include    "telemetry-delta.h"
 
 //------------------------------------------------------------------------------
 //
@@ -13,6 +14,11 @@ public:
     DataPrepare();
 
     QByteArray getPreparedData() Q_DECL_OVERRIDE;
+
+private:
+
+    /// Telemetry is sent to client as delta stream
+    TelemetryDeltaEncoder   delta_encoder;
 };
 
 #endif // DATA_PREPARE_H
@@ -0,0 +1,110 @@
+//------------------------------------------------------------------------------
+//
+//      Real time deadline monitor of simulation loop
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Real time deadline monitor of simulation loop
+ * \copyright maisvendoo
+ */
+
+#ifndef     DEADLINE_MONITOR_H
+#define     DEADLINE_MONITOR_H
+
+#include    <QElapsedTimer>
+#include    <QString>
+
+#include    <array>
+
+#include    "deadline-stats.h"
+
+/*!
+ * \class
+ * \brief Tracks wall time of timer ticks against model time
+ *
+ * Each tick integrates model time, returned by beginTick(). Lag is wall time
+ * since start minus integrated model time. Catch-up policies add the lag
+ * (limited by catch-up limit) to next tick, the rest of lag is given up
+ * and counted as slip time. Only slip policy reports, that model runs
+ * slower than real time
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class DeadlineMonitor
+{
+public:
+
+    DeadlineMonitor();
+
+    ~DeadlineMonitor();
+
+    /// Set tick interval (s), policy and catch-up limit (in intervals)
+    void init(double interval, DeadlinePolicy policy, double catchup_limit);
+
+    /// Policy by config name (none, skip-output, reduce-output, slip)
+    static bool policyFromString(const QString &name, DeadlinePolicy &policy);
+
+    /// Tick begin. Returns model time (s) to integrate in this tick
+    double beginTick();
+
+    /// Tick end with model time (s), actually integrated in this tick
+    void endTick(double model_time);
+
+    /// Is viewer output allowed in current tick
+    bool isOutputAllowed() const;
+
+    /// Count viewer output, skipped by policy
+    void skipOutput();
+
+    /// Viewer output interval multiplier
+    int getOutputDivider() const;
+
+    /// Model runs slower than real time (slip policy only)
+    bool isSlipping() const;
+
+    /// Statistics for time since previous call
+    deadline_stats_t takeStats();
+
+private:
+
+    DeadlinePolicy  policy;
+
+    qint64      interval;
+    qint64      catchup_limit;
+
+    QElapsedTimer   clock;
+
+    /// Wall time of current tick begin
+    qint64      tick_begin;
+    /// Wall time of previous tick begin
+    qint64      prev_tick_begin;
+    /// Integrated model time (ns) since start, shifted by given up lag
+    qint64      model_time;
+    qint64      lag;
+
+    int         consecutive_overruns;
+    int         consecutive_on_time;
+    int         output_divider;
+    bool        is_output_allowed;
+    bool        is_slipping;
+
+    deadline_stats_t    stats;
+
+    /// Recent jitter samples (ns)
+    std::array<qint64, DEADLINE_JITTER_SAMPLES> jitter;
+    size_t      jitter_count;
+
+    /// Report window
+    qint64      window_begin;
+    qint64      window_model_time;
+    qint64      window_exec_sum;
+    qint64      window_exec_max;
+    quint64     window_ticks;
+
+    void setSlipping(bool slipping);
+};
+
+#endif // DEADLINE_MONITOR_H
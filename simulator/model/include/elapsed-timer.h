@@ -1,8 +1,17 @@
 #ifndef     ELAPSED_TIMER_H
 #define     ELAPSED_TIMER_H
 
-#include    <QThread>
-
+#include    <QObject>
+
+/*!
+ * \class
+ * \brief Simulation timer
+ *
+ * Runs in thread, which has called start(), and never returns. Thread sleeps
+ * till absolute deadline of next tick, waking up to process Qt events not
+ * rarer than events interval. Last spin time before deadline thread neither
+ * sleeps nor processes events, so tick is emitted in time
+ */
 class ElapsedTimer : public QObject
 {
     Q_OBJECT
@@ -13,10 +22,25 @@ public:
 
     ~ElapsedTimer();
 
+    /// Tick interval, ms
     void setInterval(quint64 interval);
 
+    /// Busy wait before deadline, us (0 - sleep till deadline)
+    void setSpinTime(quint64 spin_time);
+
+    /// Interval of Qt events processing between ticks, us
+    void setEventsInterval(quint64 events_interval);
+
+    /// Pin timer thread to CPU core (negative - don't pin)
+    void setCpu(int cpu);
+
+    /// SCHED_FIFO priority of timer thread (0 - default scheduling)
+    void setRealtimePriority(int priority);
+
     void start();
 
+    void stop();
+
 signals:
 
     void process();
@@ -27,7 +51,16 @@ private:
 
     quint64 interval;
 
-    QThread thread;
+    quint64 spin_time;
+
+    quint64 events_interval;
+
+    int     cpu;
+
+    int     realtime_priority;
+
+    /// Apply CPU affinity and scheduling policy to current thread
+    void setupThread();
 
 private slots:
 
@@ -0,0 +1,64 @@
+//------------------------------------------------------------------------------
+//
+//      Lock-free publisher of simulator feedback into shared memory
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Lock-free publisher of simulator feedback into shared memory
+ * \copyright maisvendoo
+ */
+
+#ifndef     FEEDBACK_PUBLISHER_H
+#define     FEEDBACK_PUBLISHER_H
+
+#include    <QSharedMemory>
+
+#include    "shared-feedback.h"
+
+/*!
+ * \class
+ * \brief Writer of feedback segment
+ *
+ * Data is written into the buffer following the last published one, so
+ * reader, which copies last buffer, is not disturbed. Reader detects
+ * torn copy by sequence counter. Writer never waits for reader
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class FeedbackPublisher
+{
+public:
+
+    FeedbackPublisher();
+
+    ~FeedbackPublisher();
+
+    /// Create (or attach) shared memory segment and write header
+    bool init(size_t capacity, const QString &key = FEEDBACK_SHARED_KEY);
+
+    /// Publish telemetry packet
+    void publish(const char *packet, size_t size);
+
+    bool isReady() const;
+
+    /// Segment begin (nullptr - segment isn't created)
+    const void *getSegment() const;
+
+    /// Maximal packet size
+    size_t getCapacity() const;
+
+private:
+
+    QSharedMemory       shared_memory;
+
+    /// Segment begin
+    void        *segment;
+
+    /// Maximal packet size
+    size_t      capacity;
+};
+
+#endif // FEEDBACK_PUBLISHER_H
@@ -0,0 +1,61 @@
+//------------------------------------------------------------------------------
+//
+//      Lock-free reader of keyboard state from shared memory
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Lock-free reader of keyboard state from shared memory
+ * \copyright maisvendoo
+ */
+
+#ifndef     KEYS_READER_H
+#define     KEYS_READER_H
+
+#include    <QSharedMemory>
+
+#include    "shared-keys.h"
+#include    "keys-state.h"
+
+/*!
+ * \class
+ * \brief Reader of keyboard segment
+ *
+ * Bitset is copied into snapshot without locks. Keys, pressed since
+ * previous read, are taken from events ring buffer, so short key press
+ * between two reads is not lost. If client writes serialized key map
+ * (old segment format), it is decoded under segment lock
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class KeysReader
+{
+public:
+
+    KeysReader();
+
+    ~KeysReader();
+
+    /// Create (or attach) shared memory segment
+    bool init(int buffer_size, const QString &key = KEYS_SHARED_KEY);
+
+    /// Update keyboard state snapshot
+    void read(KeysState &keys);
+
+private:
+
+    QSharedMemory   shared_memory;
+
+    /// Events count at previous read
+    quint32         events_count;
+
+    /// Read segment in bitset format
+    void readBitset(const void *segment, KeysState &keys);
+
+    /// Read segment with serialized QMap<int, bool>
+    void readLegacy(KeysState &keys);
+};
+
+#endif // KEYS_READER_H
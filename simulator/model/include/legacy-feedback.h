@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+//
+//      Writer of old locked feedback segment
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Writer of old locked feedback segment
+ * \copyright maisvendoo
+ */
+
+#ifndef     LEGACY_FEEDBACK_H
+#define     LEGACY_FEEDBACK_H
+
+#include    <QThread>
+#include    <QSharedMemory>
+
+#include    <vector>
+
+#include    "server-data-struct.h"
+
+/*!
+ * \class
+ * \brief Copies lock-free feedback into old "sim" segment for old viewers
+ *
+ * Runs in own thread: reads last packet from lock-free feedback segment,
+ * restores fixed server_data_t from it and copies it into old segment
+ * under segment lock. So simulation thread never waits for a lock held
+ * by viewer
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class LegacyFeedback : public QThread
+{
+public:
+
+    LegacyFeedback(QObject *parent = Q_NULLPTR);
+
+    ~LegacyFeedback();
+
+    /// Create (or attach) old segment. Feedback is read from lock-free
+    /// segment with given packet capacity every interval (ms)
+    bool init(const void *feedback_segment,
+              size_t capacity,
+              unsigned long interval,
+              const QString &key = "sim");
+
+    /// Stop thread and wait for it
+    void stop();
+
+protected:
+
+    void run();
+
+private:
+
+    QSharedMemory   shared_memory;
+
+    /// Lock-free feedback segment
+    const void      *feedback_segment;
+
+    /// Polling interval, ms
+    unsigned long   interval;
+
+    /// Last packet from lock-free segment
+    std::vector<char>   packet;
+
+    /// Data, restored from packet
+    server_data_t   data;
+
+    /// Counter of last copied data
+    unsigned long   last_count;
+
+    bool            is_copied;
+};
+
+#endif // LEGACY_FEEDBACK_H
@@ -31,12 +31,19 @@
 
 #include    "profile.h"
 
-#include    "keys-control.h"
+#include    "keys-reader.h"
 
 #include    "virtual-interface-device.h"
 
 #include    "sim-client.h"
 
+#include    "feedback-publisher.h"
+#include    "legacy-feedback.h"
+#include    "telemetry-writer.h"
+#include    "batch-writer.h"
+#include    "control-script.h"
+#include    "deadline-monitor.h"
+
 #if defined(MODEL_LIB)
     #define MODEL_EXPORT Q_DECL_EXPORT
 #else
@@ -66,13 +73,20 @@ public:
     /// Check is simulation started
     bool isStarted() const;
 
+    /// Check is model initialized for batch simulation
+    bool isBatchMode() const;
+
+    /// Simulation from start to stop time as fast as possible
+    bool runBatch();
+
 signals:
 
     void logMessage(QString msg);
 
     void sendDataToServer(QByteArray data);
 
-    void sendDataToTrain(QByteArray data);
+    /// Deadline statistics record (deadline_stats_t)
+    void sendDeadlineStats(QByteArray data);
 
     void getRecvData(sim_dispatcher_data_t &disp_data);
 
@@ -111,6 +125,33 @@ private:
     double      control_time;
     double      control_delay;
 
+    /// Time since last feedback publishing
+    double      feedback_time;
+    /// Feedback publishing interval
+    double      feedback_delay;
+    /// Write feedback into old locked shared memory too
+    bool        is_legacy_feedback;
+    /// Model time since last profiler report
+    double      profiler_dump_time;
+    /// Profiler report interval
+    double      profiler_dump_delay;
+    /// Reaction to missed real time deadlines
+    DeadlinePolicy  deadline_policy;
+    /// Maximal lag to catch up, in integration time intervals
+    double      deadline_catchup_limit;
+    /// Model time since last deadline statistics report
+    double      deadline_report_time;
+    /// Deadline statistics report interval
+    double      deadline_report_delay;
+    /// TCP server port (0 - server is not started)
+    int         server_port;
+    /// Overruns count at last report
+    quint64     deadline_overruns;
+    /// Headless simulation without real time pacing and output to viewer
+    bool        is_batch_mode;
+    /// Batch output file from command line
+    QString     batch_output;
+
     /// Train model
     Train       *train;    
 
@@ -129,20 +170,36 @@ private:
     /// Simulation thread
     QThread     model_thread;
 
-    KeysControl keys_control;
-
     /// Server data to clinet transmission
     server_data_t   viewer_data;
 
-    QSharedMemory   shared_memory;
-    QSharedMemory   keys_data;
-    QByteArray      data;
+    /// Lock-free feedback to viewer
+    FeedbackPublisher   feedback_publisher;
+
+    /// Old locked feedback, written from own thread
+    LegacyFeedback      legacy_feedback;
+
+    /// Compact telemetry packet
+    TelemetryWriter     telemetry;
+
+    /// Batch mode signals output
+    BatchWriter         batch_writer;
+
+    /// Batch mode keys events
+    ControlScript       control_script;
+    /// Keyboard state reader
+    KeysReader      keys_reader;
+    /// Keyboard state, shared by all vehicles
+    KeysState       keys_state;
 
     QTimer          controlTimer;
     QTimer          networkTimer;
 
     ElapsedTimer    simTimer;       
 
+    /// Real time deadline monitor of simulation loop
+    DeadlineMonitor deadline_monitor;
+
     /// Actions, which prerare integration step
     void preStep(double t);
     /// Simulation step
@@ -166,6 +223,9 @@ private:
 
     void initSimClient(QString cfg_path);
 
+    /// Start TCP server (viewer data and deadline statistics)
+    void initServer();
+
     /// TCP feedback
     void tcpFeedBack();
 
@@ -175,6 +235,14 @@ private:
 
     void controlStep(double &control_time, const double control_delay);    
 
+    void feedbackStep(double &feedback_time, const double feedback_delay);
+
+    /// Periodic deadline statistics report
+    void deadlineStep(double elapsed);
+
+    /// Periodic step profiler report (if profiler is built)
+    void profilerStep(double elapsed);
+
 private slots:
 
     void process();
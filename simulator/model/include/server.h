@@ -69,6 +69,9 @@ public slots:
     /// Send data to client
     void sendDataToClient(QByteArray data);
 
+    /// Send deadline statistics to monitor client
+    void sendStatsToClient(QByteArray data);
+
 private:        
 
     /// Server object
@@ -77,6 +80,9 @@ private:
     /// Connected clients objects
     clients_t   clients;
 
+    /// Connected monitor client (deadline statistics)
+    clients_t   monitor;
+
 private slots:
 
     /// Perform when client authorized
@@ -0,0 +1,82 @@
+//------------------------------------------------------------------------------
+//
+//      Delta encoding of telemetry stream
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Delta encoding of telemetry stream
+ * \copyright maisvendoo
+ */
+
+#ifndef     TELEMETRY_DELTA_H
+#define     TELEMETRY_DELTA_H
+
+#include    <QByteArray>
+#include    <vector>
+
+#include    "telemetry.h"
+
+/*!
+ * \class
+ * \brief Converter of full telemetry packets into delta stream
+ *
+ * Encoder keeps signals, which are sent last time. Analog and discrete
+ * signals of next packet are sent as changes only. Each packet gets next
+ * sequence number. Keyframe is sent first, then periodically, and when
+ * packet layout is changed
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class TelemetryDeltaEncoder
+{
+public:
+
+    TelemetryDeltaEncoder();
+
+    ~TelemetryDeltaEncoder();
+
+    /// Set number of packets between keyframes
+    void setKeyframeInterval(int interval);
+
+    /// Force keyframe as next packet
+    void reset();
+
+    /// Encode full packet. Input, which is not a telemetry packet,
+    /// is returned as is
+    QByteArray encode(const QByteArray &packet);
+
+private:
+
+    /// Stream sequence number
+    quint32     sequence;
+
+    /// Number of packets between keyframes
+    int         keyframe_interval;
+
+    /// Packets since last keyframe
+    int         packets_count;
+
+    /// Keyframe is required
+    bool        is_keyframe_required;
+
+    /// Layout of last packet
+    size_t      vehicles_num;
+    size_t      analog_num;
+    size_t      discrete_num;
+    quint16     signal_sets;
+
+    /// Last sent signals
+    std::vector<float>  analog;
+    std::vector<quint8> discrete;
+
+    /// Encoded packet
+    QByteArray  out;
+
+    /// Store signals of full packet as sent ones
+    void storeSignals(const char *analog_block, const char *discrete_block);
+};
+
+#endif // TELEMETRY_DELTA_H
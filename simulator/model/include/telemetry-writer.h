@@ -0,0 +1,66 @@
+//------------------------------------------------------------------------------
+//
+//      Compact telemetry packet writer
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Compact telemetry packet writer
+ * \copyright maisvendoo
+ */
+
+#ifndef     TELEMETRY_WRITER_H
+#define     TELEMETRY_WRITER_H
+
+#include    <QByteArray>
+#include    <vector>
+
+#include    "telemetry.h"
+
+class Vehicle;
+
+/*!
+ * \class
+ * \brief Writer of vehicles data into telemetry packet
+ *
+ * Packet buffer is allocated once for maximal size, so packet writing
+ * doesn't allocate memory. Packet must not be shared (copied by value),
+ * otherwise next write detaches and reallocates it
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class TelemetryWriter
+{
+public:
+
+    TelemetryWriter();
+
+    ~TelemetryWriter();
+
+    /// Select signal sets. Zero signals number excludes set from packet
+    void setSignals(size_t analog_num, size_t discrete_num, bool is_debug);
+
+    /// Maximal packet size for given vehicles number
+    size_t getMaxSize(size_t vehicles_num) const;
+
+    /// Write packet
+    const QByteArray &write(const std::vector<Vehicle *> &vehicles,
+                            float time,
+                            quint64 count,
+                            quint32 route_id = 0);
+
+    /// Last written packet
+    const QByteArray &getPacket() const;
+
+private:
+
+    quint16     analog_num;
+    quint16     discrete_num;
+    bool        is_debug;
+
+    QByteArray  packet;
+};
+
+#endif // TELEMETRY_WRITER_H
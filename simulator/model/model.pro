@@ -6,6 +6,12 @@ QT += network
 
 DEFINES += MODEL_LIB
 
+# Step profiler instrumentation (qmake CONFIG+=step_profiler)
+step_profiler {
+
+    DEFINES += STEP_PROFILER
+}
+
 TARGET = model
 
 DESTDIR = ../../../lib
@@ -57,6 +63,9 @@ win32{
     OPENAL_INCLUDE_BIN = $$(OPENAL_INCLUDE)
 
     LIBS += -L$$OPENAL_LIB_DIR -lOpenAL32
+
+    # timeBeginPeriod() for simulation timer
+    LIBS += -lwinmm
     INCLUDEPATH += $$OPENAL_INCLUDE_BIN
 }
 
@@ -0,0 +1,323 @@
+//------------------------------------------------------------------------------
+//
+//      Signals output of batch simulation
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Signals output of batch simulation
+ * \copyright maisvendoo
+ */
+
+#include    "batch-writer.h"
+
+#include    "CfgReader.h"
+#include    "Journal.h"
+#include    "filesystem.h"
+#include    "vehicle.h"
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+BatchWriter::BatchWriter()
+    : vehicles(nullptr)
+    , interval(0.1)
+    , begin_time(0.0)
+    , next_time(0.0)
+    , rows_count(0)
+    , prev_time(0.0)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+BatchWriter::~BatchWriter()
+{
+    close();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool BatchWriter::init(const QString &cfg_path,
+                       const QString &output_path,
+                       std::vector<Vehicle *> *vehicles)
+{
+    this->vehicles = vehicles;
+
+    FileSystem &fs = FileSystem::getInstance();
+    QString file_name = "batch.csv";
+
+    CfgReader cfg;
+
+    if (cfg.load(cfg_path))
+    {
+        QString secName = "Batch";
+
+        if (!cfg.getString(secName, "OutputFile", file_name))
+        {
+            file_name = "batch.csv";
+        }
+
+        if (!cfg.getDouble(secName, "OutputInterval", interval) || (interval <= 0))
+        {
+            interval = 0.1;
+        }
+
+        loadSignals(cfg);
+    }
+    else
+    {
+        Journal::instance()->warning("File " + cfg_path + " not found. Using default batch output");
+    }
+
+    if (signals_list.empty())
+        setDefaultSignals();
+
+    QString path = output_path;
+
+    if (path.isEmpty())
+        path = QString(fs.combinePath(fs.getLogsDir(), file_name.toStdString()).c_str());
+
+    file.setFileName(path);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        Journal::instance()->error("Can't open batch output file " + path);
+        return false;
+    }
+
+    // Header
+    row = "t";
+
+    for (auto it = signals_list.begin(); it != signals_list.end(); ++it)
+    {
+        row += ';';
+        row += it->name.toUtf8();
+    }
+
+    row += '\n';
+    file.write(row);
+
+    begin_time = next_time = 0.0;
+    rows_count = 0;
+
+    prev_values.resize(signals_list.size());
+    values.resize(signals_list.size());
+    grid_values.resize(signals_list.size());
+
+    Journal::instance()->info(QString("Batch output: %1 signals into file %2")
+                              .arg(signals_list.size())
+                              .arg(path));
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void BatchWriter::write(double t)
+{
+    if (!file.isOpen())
+        return;
+
+    for (size_t i = 0; i < signals_list.size(); ++i)
+        values[i] = getValue(signals_list[i]);
+
+    // Grid begins at first written time (StartTime of the run)
+    if (rows_count == 0)
+    {
+        writeRow(t, values);
+
+        begin_time = t;
+        next_time = begin_time + interval;
+    }
+
+    // Rows, which fall on grid between previous and current step
+    while ( (t >= next_time) && (t > prev_time) )
+    {
+        double theta = (next_time - prev_time) / (t - prev_time);
+
+        for (size_t i = 0; i < signals_list.size(); ++i)
+        {
+            if (signals_list[i].type == batch_signal_t::SIGNAL_DISCRETE)
+                grid_values[i] = (theta < 1.0) ? prev_values[i] : values[i];
+            else
+                grid_values[i] = prev_values[i] + theta * (values[i] - prev_values[i]);
+        }
+
+        writeRow(next_time, grid_values);
+
+        // Grid time isn't accumulated, so it doesn't drift
+        next_time = begin_time + static_cast<double>(rows_count) * interval;
+    }
+
+    prev_time = t;
+    prev_values.swap(values);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void BatchWriter::writeRow(double t, const std::vector<double> &row_values)
+{
+    row.clear();
+    row += QByteArray::number(t, 'g', 10);
+
+    for (double value : row_values)
+    {
+        row += ';';
+        row += QByteArray::number(value, 'g', 10);
+    }
+
+    row += '\n';
+
+    file.write(row);
+    rows_count++;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void BatchWriter::close()
+{
+    if (file.isOpen())
+        file.close();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+quint64 BatchWriter::getRowsCount() const
+{
+    return rows_count;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void BatchWriter::loadSignals(CfgReader &cfg)
+{
+    QDomNode signal_node = cfg.getFirstSection("Signal");
+
+    while (!signal_node.isNull())
+    {
+        batch_signal_t signal;
+
+        int vehicle_idx = 0;
+        cfg.getInt(signal_node, "Vehicle", vehicle_idx);
+
+        int index = 0;
+        cfg.getInt(signal_node, "Index", index);
+
+        QString type = "Coord";
+        cfg.getString(signal_node, "Type", type);
+
+        if (type == "Velocity")
+            signal.type = batch_signal_t::SIGNAL_VELOCITY;
+        else if (type == "Analog")
+            signal.type = batch_signal_t::SIGNAL_ANALOG;
+        else if (type == "Discrete")
+            signal.type = batch_signal_t::SIGNAL_DISCRETE;
+        else if (type == "CouplingForce")
+            signal.type = batch_signal_t::SIGNAL_COUPLING_FORCE;
+        else
+            signal.type = batch_signal_t::SIGNAL_COORD;
+
+        bool is_valid = (vehicle_idx >= 0) &&
+                (static_cast<size_t>(vehicle_idx) < vehicles->size()) &&
+                (index >= 0);
+
+        if ( (signal.type == batch_signal_t::SIGNAL_ANALOG) && (index >= MAX_ANALOG_SIGNALS) )
+            is_valid = false;
+
+        if ( (signal.type == batch_signal_t::SIGNAL_DISCRETE) && (index >= MAX_DISCRETE_SIGNALS) )
+            is_valid = false;
+
+        if (is_valid)
+        {
+            signal.vehicle = static_cast<size_t>(vehicle_idx);
+            signal.index = static_cast<size_t>(index);
+
+            if (!cfg.getString(signal_node, "Name", signal.name))
+            {
+                signal.name = QString("%1[%2].%3").arg(type).arg(vehicle_idx).arg(index);
+            }
+
+            signals_list.push_back(signal);
+        }
+        else
+        {
+            Journal::instance()->warning(QString("Batch signal %1 of vehicle %2 is ignored")
+                                         .arg(type)
+                                         .arg(vehicle_idx));
+        }
+
+        signal_node = cfg.getNextSection();
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void BatchWriter::setDefaultSignals()
+{
+    if (vehicles->empty())
+        return;
+
+    size_t last = vehicles->size() - 1;
+
+    batch_signal_t signal;
+
+    signal.name = "x_first";
+    signal.vehicle = 0;
+    signal.type = batch_signal_t::SIGNAL_COORD;
+    signals_list.push_back(signal);
+
+    signal.name = "v_first";
+    signal.type = batch_signal_t::SIGNAL_VELOCITY;
+    signals_list.push_back(signal);
+
+    signal.name = "x_last";
+    signal.vehicle = last;
+    signal.type = batch_signal_t::SIGNAL_COORD;
+    signals_list.push_back(signal);
+
+    signal.name = "v_last";
+    signal.type = batch_signal_t::SIGNAL_VELOCITY;
+    signals_list.push_back(signal);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+double BatchWriter::getValue(const batch_signal_t &signal) const
+{
+    Vehicle *vehicle = vehicles->at(signal.vehicle);
+
+    switch (signal.type)
+    {
+    case batch_signal_t::SIGNAL_VELOCITY:
+
+        return vehicle->getVelocity();
+
+    case batch_signal_t::SIGNAL_ANALOG:
+
+        return static_cast<double>(vehicle->getAnalogSignal(signal.index));
+
+    case batch_signal_t::SIGNAL_DISCRETE:
+
+        return vehicle->getDiscreteSignal(signal.index) ? 1.0 : 0.0;
+
+    case batch_signal_t::SIGNAL_COUPLING_FORCE:
+
+        return vehicle->getBackwardForce();
+
+    default:
+
+        return vehicle->getRailwayCoord();
+    }
+}
@@ -0,0 +1,119 @@
+//------------------------------------------------------------------------------
+//
+//      Timed keys events for batch simulation
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Timed keys events for batch simulation
+ * \copyright maisvendoo
+ */
+
+#include    "control-script.h"
+
+#include    <algorithm>
+
+#include    "CfgReader.h"
+#include    "Journal.h"
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+ControlScript::ControlScript()
+    : next_event(0)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+ControlScript::~ControlScript()
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool ControlScript::load(const QString &path)
+{
+    CfgReader cfg;
+
+    if (!cfg.load(path))
+    {
+        Journal::instance()->error("Control script " + path + " is't found");
+        return false;
+    }
+
+    events.clear();
+    next_event = 0;
+
+    QDomNode event_node = cfg.getFirstSection("Event");
+
+    while (!event_node.isNull())
+    {
+        control_event_t event;
+        QString key = "";
+
+        if (!cfg.getDouble(event_node, "Time", event.time) ||
+            !cfg.getString(event_node, "Key", key))
+        {
+            Journal::instance()->warning("Control script event without Time or Key is ignored");
+            event_node = cfg.getNextSection();
+            continue;
+        }
+
+        if (!cfg.getBool(event_node, "State", event.state))
+        {
+            event.state = true;
+        }
+
+        bool ok = true;
+
+        if (key.length() == 1)
+            event.key = key.toLatin1().at(0);
+        else
+            event.key = key.toInt(&ok, 0);
+
+        if (ok)
+            events.push_back(event);
+        else
+            Journal::instance()->warning("Unknown key " + key + " in control script");
+
+        event_node = cfg.getNextSection();
+    }
+
+    std::stable_sort(events.begin(), events.end(),
+                     [](const control_event_t &a, const control_event_t &b)
+    {
+        return a.time < b.time;
+    });
+
+    Journal::instance()->info(QString("Loaded %1 events from control script %2")
+                              .arg(events.size())
+                              .arg(path));
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void ControlScript::step(double t, KeysState &keys)
+{
+    while ( (next_event < events.size()) && (events[next_event].time <= t) )
+    {
+        keys.setKeyState(events[next_event].key, events[next_event].state);
+        next_event++;
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+size_t ControlScript::getEventsCount() const
+{
+    return events.size();
+}
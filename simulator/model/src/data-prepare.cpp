@@ -14,5 +14,7 @@ DataPrepare::DataPrepare() : AbstractDataEngine()
 QByteArray DataPrepare::getPreparedData()
 {
     QMutexLocker locker(&outMutex_);
-    return outputBuffer_;
+
+    // Changes since data, sent to this client last time
+    return delta_encoder.encode(outputBuffer_);
 }
@@ -0,0 +1,326 @@
+//------------------------------------------------------------------------------
+//
+//      Real time deadline monitor of simulation loop
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Real time deadline monitor of simulation loop
+ * \copyright maisvendoo
+ */
+
+#include    "deadline-monitor.h"
+
+#include    <algorithm>
+#include    <vector>
+
+#include    "Journal.h"
+
+/// Overruns in a row, which double output interval
+static const int OVERRUNS_TO_REDUCE_OUTPUT = 3;
+
+/// Ticks in time in a row, which halve output interval back
+static const int ON_TIME_TO_RESTORE_OUTPUT = 50;
+
+/// Maximal output interval multiplier
+static const int MAX_OUTPUT_DIVIDER = 8;
+
+/// Ticks without slip, after which model is considered as real time again
+static const int ON_TIME_TO_LEAVE_SLIP = 10;
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static float toMs(qint64 ns)
+{
+    return static_cast<float>(static_cast<double>(ns) * 1e-6);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+DeadlineMonitor::DeadlineMonitor()
+    : policy(DEADLINE_POLICY_NONE)
+    , interval(100000000)
+    , catchup_limit(0)
+    , tick_begin(0)
+    , prev_tick_begin(0)
+    , model_time(0)
+    , lag(0)
+    , consecutive_overruns(0)
+    , consecutive_on_time(0)
+    , output_divider(1)
+    , is_output_allowed(true)
+    , is_slipping(false)
+    , jitter_count(0)
+    , window_begin(0)
+    , window_model_time(0)
+    , window_exec_sum(0)
+    , window_exec_max(0)
+    , window_ticks(0)
+{
+    jitter.fill(0);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+DeadlineMonitor::~DeadlineMonitor()
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void DeadlineMonitor::init(double interval, DeadlinePolicy policy, double catchup_limit)
+{
+    this->interval = std::max(static_cast<qint64>(interval * 1e9), static_cast<qint64>(1));
+    this->policy = policy;
+    this->catchup_limit = static_cast<qint64>(std::max(catchup_limit, 0.0) * static_cast<double>(this->interval));
+
+    stats.policy = static_cast<quint16>(policy);
+    stats.interval = toMs(this->interval);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool DeadlineMonitor::policyFromString(const QString &name, DeadlinePolicy &policy)
+{
+    QString n = name.trimmed().toLower();
+
+    if (n == "none")
+        policy = DEADLINE_POLICY_NONE;
+    else if (n == "skip-output")
+        policy = DEADLINE_POLICY_SKIP_OUTPUT;
+    else if (n == "reduce-output")
+        policy = DEADLINE_POLICY_REDUCE_OUTPUT;
+    else if (n == "slip")
+        policy = DEADLINE_POLICY_SLIP;
+    else
+        return false;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+double DeadlineMonitor::beginTick()
+{
+    if (!clock.isValid())
+    {
+        clock.start();
+        return static_cast<double>(interval) * 1e-9;
+    }
+
+    prev_tick_begin = tick_begin;
+    tick_begin = clock.nsecsElapsed();
+    stats.ticks++;
+
+    qint64 period = tick_begin - prev_tick_begin;
+
+    jitter[jitter_count % jitter.size()] = std::abs(period - interval);
+    jitter_count++;
+
+    if (period >= 2 * interval)
+        stats.missed_ticks += static_cast<quint64>(period / interval - 1);
+
+    // Model interval of this tick should have begun at model_time
+    lag = tick_begin - model_time;
+
+    // Timer tick came early (or timer rephased after overrun), model is not
+    // slowed down, but schedule is moved to timer
+    if (lag < 0)
+    {
+        model_time = tick_begin;
+        lag = 0;
+    }
+
+    qint64 catchup = 0;
+
+    if ( (policy == DEADLINE_POLICY_SKIP_OUTPUT) ||
+         (policy == DEADLINE_POLICY_REDUCE_OUTPUT) )
+    {
+        catchup = std::min(lag, catchup_limit);
+    }
+
+    // Lag, which is not caught up, is given up for ever
+    qint64 slip = lag - catchup;
+
+    model_time += slip;
+    lag -= slip;
+    stats.slip_time += toMs(slip);
+
+    // Only slip policy reports, that model runs slower than real time.
+    // Other policies count given up lag in statistics only
+    if (policy == DEADLINE_POLICY_SLIP)
+    {
+        if (slip > interval / 4)
+        {
+            consecutive_on_time = 0;
+            setSlipping(true);
+        }
+        else if (is_slipping && (consecutive_on_time >= ON_TIME_TO_LEAVE_SLIP))
+        {
+            setSlipping(false);
+        }
+    }
+
+    is_output_allowed = (policy != DEADLINE_POLICY_SKIP_OUTPUT) ||
+                        ( (catchup <= interval / 2) && (consecutive_overruns == 0) );
+
+    return static_cast<double>(interval + catchup) * 1e-9;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void DeadlineMonitor::endTick(double model_time)
+{
+    qint64 tick_model_time = static_cast<qint64>(model_time * 1e9);
+    qint64 exec = clock.nsecsElapsed() - tick_begin;
+
+    this->model_time += tick_model_time;
+
+    window_model_time += tick_model_time;
+    window_exec_sum += exec;
+    window_exec_max = std::max(window_exec_max, exec);
+    window_ticks++;
+
+    if (exec > interval)
+    {
+        stats.overruns++;
+        consecutive_overruns++;
+        consecutive_on_time = 0;
+
+        stats.max_consecutive_overruns = std::max(stats.max_consecutive_overruns,
+                                                  static_cast<quint32>(consecutive_overruns));
+    }
+    else
+    {
+        consecutive_overruns = 0;
+        consecutive_on_time++;
+    }
+
+    if (policy != DEADLINE_POLICY_REDUCE_OUTPUT)
+        return;
+
+    if ( (consecutive_overruns > 0) &&
+         (consecutive_overruns % OVERRUNS_TO_REDUCE_OUTPUT == 0) &&
+         (output_divider < MAX_OUTPUT_DIVIDER) )
+    {
+        output_divider *= 2;
+    }
+
+    if ( (consecutive_on_time >= ON_TIME_TO_RESTORE_OUTPUT) && (output_divider > 1) )
+    {
+        output_divider /= 2;
+        consecutive_on_time = 0;
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool DeadlineMonitor::isOutputAllowed() const
+{
+    return is_output_allowed;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void DeadlineMonitor::skipOutput()
+{
+    stats.skipped_outputs++;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int DeadlineMonitor::getOutputDivider() const
+{
+    return output_divider;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool DeadlineMonitor::isSlipping() const
+{
+    return is_slipping;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+deadline_stats_t DeadlineMonitor::takeStats()
+{
+    qint64 now = clock.isValid() ? clock.nsecsElapsed() : 0;
+    qint64 wall_time = now - window_begin;
+
+    stats.realtime_factor = (wall_time > 0) ?
+                static_cast<float>(static_cast<double>(window_model_time) / static_cast<double>(wall_time)) :
+                1.0f;
+
+    stats.exec_mean = (window_ticks > 0) ?
+                toMs(window_exec_sum / static_cast<qint64>(window_ticks)) :
+                0.0f;
+
+    stats.exec_max = toMs(window_exec_max);
+
+    size_t n = std::min(jitter_count, jitter.size());
+
+    if (n > 0)
+    {
+        std::vector<qint64> samples(jitter.begin(), jitter.begin() + static_cast<std::ptrdiff_t>(n));
+
+        auto percentile = [&samples, n](double q) -> float
+        {
+            auto it = samples.begin() + static_cast<std::ptrdiff_t>(q * static_cast<double>(n - 1));
+            std::nth_element(samples.begin(), it, samples.end());
+            return toMs(*it);
+        };
+
+        stats.jitter_p50 = percentile(0.50);
+        stats.jitter_p95 = percentile(0.95);
+        stats.jitter_p99 = percentile(0.99);
+        stats.jitter_max = toMs(*std::max_element(samples.begin(), samples.end()));
+    }
+
+    stats.lag = toMs(lag);
+    stats.output_divider = static_cast<quint16>(output_divider);
+    stats.is_slipping = is_slipping ? 1 : 0;
+
+    window_begin = now;
+    window_model_time = 0;
+    window_exec_sum = 0;
+    window_exec_max = 0;
+    window_ticks = 0;
+
+    return stats;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void DeadlineMonitor::setSlipping(bool slipping)
+{
+    if (slipping == is_slipping)
+        return;
+
+    is_slipping = slipping;
+
+    if (is_slipping)
+    {
+        Journal::instance()->warning(QString("Simulation runs slower than real time, lag %1 ms given up")
+                                     .arg(static_cast<double>(stats.slip_time)));
+    }
+    else
+    {
+        Journal::instance()->info("Simulation runs in real time again");
+    }
+}
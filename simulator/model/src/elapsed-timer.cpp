@@ -1,17 +1,57 @@
 #include    "elapsed-timer.h"
 
-#include    <QElapsedTimer>
 #include    <QTimer>
 #include    <QEventLoop>
 
+#include    <algorithm>
+#include    <chrono>
+#include    <thread>
+
+#if defined(Q_OS_LINUX)
+    #include    <cerrno>
+    #include    <ctime>
+    #include    <pthread.h>
+    #include    <sched.h>
+#elif defined(Q_OS_WIN)
+    #include    <windows.h>
+#endif
+
 #include    "Journal.h"
 
+typedef std::chrono::steady_clock   sched_clock_t;
+
+//------------------------------------------------------------------------------
+//  Sleep till absolute time point
+//------------------------------------------------------------------------------
+static void sleepUntil(sched_clock_t::time_point deadline)
+{
+#if defined(Q_OS_LINUX)
+    // steady_clock is CLOCK_MONOTONIC in libstdc++ and libc++
+    auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(deadline.time_since_epoch()).count();
+
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(ns / 1000000000);
+    ts.tv_nsec = static_cast<long>(ns % 1000000000);
+
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR)
+    {
+
+    }
+#else
+    std::this_thread::sleep_until(deadline);
+#endif
+}
+
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
 ElapsedTimer::ElapsedTimer(QObject *parent) : QObject(parent)
   , is_started(false)
   , interval(0)
+  , spin_time(200)
+  , events_interval(1000)
+  , cpu(-1)
+  , realtime_priority(0)
 {
 
 }
@@ -21,7 +61,7 @@ ElapsedTimer::ElapsedTimer(QObject *parent) : QObject(parent)
 //------------------------------------------------------------------------------
 ElapsedTimer::~ElapsedTimer()
 {
-
+    stop();
 }
 
 //------------------------------------------------------------------------------
@@ -32,14 +72,103 @@ void ElapsedTimer::setInterval(quint64 interval)
     this->interval = interval;
 }
 
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void ElapsedTimer::setSpinTime(quint64 spin_time)
+{
+    this->spin_time = spin_time;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void ElapsedTimer::setEventsInterval(quint64 events_interval)
+{
+    this->events_interval = std::max(events_interval, static_cast<quint64>(1));
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void ElapsedTimer::setCpu(int cpu)
+{
+    this->cpu = cpu;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void ElapsedTimer::setRealtimePriority(int priority)
+{
+    realtime_priority = priority;
+}
+
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
 void ElapsedTimer::start()
 {
     is_started = true;
-    connect(&thread, &QThread::started, this, &ElapsedTimer::loop);
-    thread.start();
+
+    // Loop is entered from event loop of this thread, as soon as it runs
+    QTimer::singleShot(0, this, &ElapsedTimer::loop);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void ElapsedTimer::stop()
+{
+    is_started = false;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void ElapsedTimer::setupThread()
+{
+#if defined(Q_OS_LINUX)
+    if (cpu >= 0)
+    {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(cpu, &cpu_set);
+
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpu_set) == 0)
+            Journal::instance()->info(QString("Simulation timer thread is pinned to CPU %1").arg(cpu));
+        else
+            Journal::instance()->warning(QString("Can't pin simulation timer thread to CPU %1").arg(cpu));
+    }
+
+    if (realtime_priority > 0)
+    {
+        sched_param param;
+        param.sched_priority = std::min(realtime_priority, sched_get_priority_max(SCHED_FIFO));
+
+        if (pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0)
+            Journal::instance()->info(QString("Simulation timer thread uses SCHED_FIFO priority %1").arg(param.sched_priority));
+        else
+            Journal::instance()->warning("Can't set SCHED_FIFO for simulation timer thread (no CAP_SYS_NICE?)");
+    }
+#elif defined(Q_OS_WIN)
+    if ( (cpu >= 0) && (cpu < 64) )
+    {
+        if (SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(1) << cpu) != 0)
+            Journal::instance()->info(QString("Simulation timer thread is pinned to CPU %1").arg(cpu));
+        else
+            Journal::instance()->warning(QString("Can't pin simulation timer thread to CPU %1").arg(cpu));
+    }
+
+    if (realtime_priority > 0)
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL);
+
+    // Default Windows timer resolution is 15.6 ms
+    timeBeginPeriod(1);
+#else
+    if ( (cpu >= 0) || (realtime_priority > 0) )
+        Journal::instance()->warning("Simulation timer thread affinity and priority aren't supported");
+#endif
 }
 
 //------------------------------------------------------------------------------
@@ -47,17 +176,55 @@ void ElapsedTimer::start()
 //------------------------------------------------------------------------------
 void ElapsedTimer::loop()
 {
-    QTimer *timer = new QTimer(this);
-    connect(timer, &QTimer::timeout, this, &ElapsedTimer::process, Qt::DirectConnection);
-    timer->setTimerType(Qt::PreciseTimer);
-    timer->start(static_cast<int>(interval));
+    setupThread();
+
+    Journal::instance()->info(QString("Started simulation timer with interval %1 ms, spin %2 us")
+                              .arg(interval)
+                              .arg(spin_time));
 
-    Journal::instance()->info(QString("Started simulation timer with interval %1").arg(interval));
+    const sched_clock_t::duration period = std::chrono::milliseconds(interval);
+    const sched_clock_t::duration spin = std::chrono::microseconds(spin_time);
+    const sched_clock_t::duration events_period = std::chrono::microseconds(events_interval);
 
     QEventLoop eventLoop;
 
+    sched_clock_t::time_point deadline = sched_clock_t::now() + period;
+
     while (is_started)
     {
-        eventLoop.processEvents();
+        // Sleep and process events till spin phase
+        sched_clock_t::time_point spin_begin = deadline - spin;
+        sched_clock_t::time_point now = sched_clock_t::now();
+
+        while (is_started && (now < spin_begin))
+        {
+            eventLoop.processEvents();
+
+            now = sched_clock_t::now();
+
+            if (now < spin_begin)
+            {
+                sleepUntil(std::min(now + events_period, spin_begin));
+                now = sched_clock_t::now();
+            }
+        }
+
+        if (!is_started)
+            break;
+
+        while (sched_clock_t::now() < deadline)
+        {
+
+        }
+
+        emit process();
+
+        deadline += period;
+
+        // Missed ticks aren't emitted in burst, schedule continues from now
+        now = sched_clock_t::now();
+
+        if (deadline <= now)
+            deadline = now + period - (now - deadline) % period;
     }
 }
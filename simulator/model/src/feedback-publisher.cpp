@@ -0,0 +1,152 @@
+//------------------------------------------------------------------------------
+//
+//      Lock-free publisher of simulator feedback into shared memory
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Lock-free publisher of simulator feedback into shared memory
+ * \copyright maisvendoo
+ */
+
+#include    "feedback-publisher.h"
+
+#include    <new>
+
+#include    "Journal.h"
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+FeedbackPublisher::FeedbackPublisher()
+    : segment(nullptr)
+    , capacity(0)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+FeedbackPublisher::~FeedbackPublisher()
+{
+    shared_memory.detach();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool FeedbackPublisher::init(size_t capacity, const QString &key)
+{
+    size_t segment_size = feedbackSegmentSize(capacity);
+
+    shared_memory.setKey(key);
+
+    if (!shared_memory.create(static_cast<int>(segment_size)))
+    {
+        if (!shared_memory.attach())
+        {
+            Journal::instance()->error("Can't attach to shared memory " + key);
+            return false;
+        }
+
+        if (static_cast<size_t>(shared_memory.size()) < segment_size)
+        {
+            Journal::instance()->error("Shared memory " + key + " is too small for feedback data");
+            shared_memory.detach();
+            return false;
+        }
+    }
+
+    this->capacity = capacity;
+
+    // Header is written once, under lock, while readers can't see valid
+    // signature yet
+    shared_memory.lock();
+
+    segment = shared_memory.data();
+
+    feedback_header_t *header = static_cast<feedback_header_t *>(segment);
+
+    header->magic = 0;
+
+    new (&header->latest) std::atomic<quint32>(0);
+
+    for (size_t i = 0; i < FEEDBACK_BUFFERS_NUM; ++i)
+    {
+        feedback_buffer_t *buffer = feedbackBuffer(segment, capacity, i);
+
+        new (&buffer->seq) std::atomic<quint64>(0);
+        buffer->size = 0;
+        buffer->reserved = 0;
+    }
+
+    header->layout_version = FEEDBACK_LAYOUT_VERSION;
+    header->buffers_num = FEEDBACK_BUFFERS_NUM;
+    header->buffer_capacity = static_cast<quint32>(capacity);
+
+    std::atomic_thread_fence(std::memory_order_release);
+
+    header->magic = FEEDBACK_MAGIC;
+
+    shared_memory.unlock();
+
+    Journal::instance()->info(QString("Feedback segment %1 is created, layout version %2, size %3 bytes")
+                              .arg(key).arg(FEEDBACK_LAYOUT_VERSION).arg(segment_size));
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void FeedbackPublisher::publish(const char *packet, size_t size)
+{
+    if ( (segment == nullptr) || (size > capacity) )
+        return;
+
+    feedback_header_t *header = static_cast<feedback_header_t *>(segment);
+
+    quint32 latest = header->latest.load(std::memory_order_relaxed);
+    quint32 idx = (latest + 1) % FEEDBACK_BUFFERS_NUM;
+
+    feedback_buffer_t *buffer = feedbackBuffer(segment, capacity, idx);
+
+    quint64 seq = buffer->seq.load(std::memory_order_relaxed);
+
+    // Odd counter marks buffer as being written
+    buffer->seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    buffer->size = static_cast<quint32>(size);
+    memcpy(reinterpret_cast<char *>(buffer + 1), packet, size);
+
+    buffer->seq.store(seq + 2, std::memory_order_release);
+
+    header->latest.store(idx, std::memory_order_release);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool FeedbackPublisher::isReady() const
+{
+    return segment != nullptr;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const void *FeedbackPublisher::getSegment() const
+{
+    return segment;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+size_t FeedbackPublisher::getCapacity() const
+{
+    return capacity;
+}
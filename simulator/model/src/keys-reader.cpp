@@ -0,0 +1,147 @@
+//------------------------------------------------------------------------------
+//
+//      Lock-free reader of keyboard state from shared memory
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Lock-free reader of keyboard state from shared memory
+ * \copyright maisvendoo
+ */
+
+#include    "keys-reader.h"
+
+#include    <QByteArray>
+#include    <QDataStream>
+#include    <QMap>
+
+#include    <algorithm>
+
+#include    "Journal.h"
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+KeysReader::KeysReader()
+    : events_count(0)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+KeysReader::~KeysReader()
+{
+    shared_memory.detach();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool KeysReader::init(int buffer_size, const QString &key)
+{
+    int segment_size = std::max(buffer_size, static_cast<int>(keysSegmentSize()));
+
+    shared_memory.setKey(key);
+
+    if (!shared_memory.create(segment_size))
+    {
+        if (!shared_memory.attach())
+        {
+            Journal::instance()->error("Can't attach to shread memory. Unable process keyboard");
+            return false;
+        }
+
+        // Segment is created by client, which writes its own format
+        events_count = 0;
+
+        Journal::instance()->info("Attached to shared memory for keysboard processing");
+
+        return true;
+    }
+
+    shared_memory.lock();
+    initKeysSegment(shared_memory.data());
+    shared_memory.unlock();
+
+    events_count = 0;
+
+    Journal::instance()->info("Created shared memory for keysboard processing");
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void KeysReader::read(KeysState &keys)
+{
+    if (!shared_memory.isAttached())
+        return;
+
+    const void *segment = shared_memory.constData();
+
+    if (isKeysCompatible(segment, static_cast<size_t>(shared_memory.size())))
+        readBitset(segment, keys);
+    else
+        readLegacy(keys);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void KeysReader::readBitset(const void *segment, KeysState &keys)
+{
+    const keys_header_t *header = static_cast<const keys_header_t *>(segment);
+
+    // Counter is read first, so bitset is not older than last event
+    quint32 count = header->events_count.load(std::memory_order_acquire);
+
+    const std::atomic<quint64> *bitset = keysBitset(segment);
+    quint64 *bits = keys.data();
+
+    for (size_t i = 0; i < KEYS_WORDS_NUM; ++i)
+        bits[i] = bitset[i].load(std::memory_order_relaxed);
+
+    // Keys, released before this read, are held pressed for one control step
+    quint32 pending = count - events_count;
+
+    if (pending > KEYS_EVENTS_NUM)
+        events_count = count - KEYS_EVENTS_NUM;
+
+    const std::atomic<quint32> *events = keysEvents(segment);
+
+    for (; events_count != count; ++events_count)
+    {
+        quint32 event = events[events_count % KEYS_EVENTS_NUM].load(std::memory_order_relaxed);
+
+        if (event & KEYS_EVENT_PRESSED)
+            keys.setKeyState(static_cast<int>(event & (KEYS_CODES_NUM - 1)), true);
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void KeysReader::readLegacy(KeysState &keys)
+{
+    if (!shared_memory.lock())
+        return;
+
+    QByteArray data = QByteArray::fromRawData(static_cast<const char *>(shared_memory.constData()),
+                                              shared_memory.size());
+
+    QMap<int, bool> keys_map;
+
+    QDataStream stream(&data, QIODevice::ReadOnly);
+    stream >> keys_map;
+
+    shared_memory.unlock();
+
+    keys.clear();
+
+    for (auto it = keys_map.begin(); it != keys_map.end(); ++it)
+        keys.setKeyState(it.key(), it.value());
+}
@@ -0,0 +1,115 @@
+//------------------------------------------------------------------------------
+//
+//      Writer of old locked feedback segment
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Writer of old locked feedback segment
+ * \copyright maisvendoo
+ */
+
+#include    "legacy-feedback.h"
+
+#include    <algorithm>
+#include    <cstring>
+
+#include    "shared-feedback.h"
+#include    "Journal.h"
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+LegacyFeedback::LegacyFeedback(QObject *parent)
+    : QThread(parent)
+    , feedback_segment(nullptr)
+    , interval(20)
+    , last_count(0)
+    , is_copied(false)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+LegacyFeedback::~LegacyFeedback()
+{
+    stop();
+    shared_memory.detach();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool LegacyFeedback::init(const void *feedback_segment,
+                          size_t capacity,
+                          unsigned long interval,
+                          const QString &key)
+{
+    if (feedback_segment == nullptr)
+        return false;
+
+    shared_memory.setKey(key);
+
+    if (!shared_memory.create(sizeof(server_data_t)))
+    {
+        if (!shared_memory.attach())
+        {
+            Journal::instance()->error("Can't attach to shared memory " + key);
+            return false;
+        }
+    }
+
+    this->feedback_segment = feedback_segment;
+    this->interval = std::max(interval, 1ul);
+
+    packet.resize(capacity);
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void LegacyFeedback::stop()
+{
+    if (!isRunning())
+        return;
+
+    requestInterruption();
+    wait();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void LegacyFeedback::run()
+{
+    size_t segment_size = feedbackSegmentSize(packet.size());
+
+    while (!isInterruptionRequested())
+    {
+        size_t size = 0;
+
+        bool is_read = isFeedbackCompatible(feedback_segment, segment_size) &&
+                readFeedback(feedback_segment, packet.data(), packet.size(), size) &&
+                telemetryToServerData(packet.data(), size, data);
+
+        // Viewer lock is taken only for new data
+        if (is_read && (!is_copied || (data.count != last_count)))
+        {
+            if (shared_memory.lock())
+            {
+                memcpy(shared_memory.data(), &data, sizeof (server_data_t));
+                shared_memory.unlock();
+
+                last_count = data.count;
+                is_copied = true;
+            }
+        }
+
+        msleep(interval);
+    }
+}
@@ -16,6 +16,9 @@
 #include    "model.h"
 
 #include    <QTime>
+#include    <QElapsedTimer>
+
+#include    <algorithm>
 
 #include    "CfgReader.h"
 #include    "Journal.h"
@@ -36,18 +39,24 @@ Model::Model(QObject *parent) : QObject(parent)
   , is_debug_print(false)
   , control_time(0)
   , control_delay(0.05)
+  , feedback_time(0)
+  , feedback_delay(0.02)
+  , is_legacy_feedback(true)
+  , profiler_dump_time(0)
+  , profiler_dump_delay(10.0)
+  , deadline_policy(DEADLINE_POLICY_NONE)
+  , deadline_catchup_limit(2.0)
+  , deadline_report_time(0)
+  , deadline_report_delay(1.0)
+  , server_port(0)
+  , deadline_overruns(0)
+  , is_batch_mode(false)
+  , batch_output("")
   , train(nullptr)
   , profile(nullptr)
   , server(nullptr)
   , control_panel(nullptr)
 {
-    shared_memory.setKey("sim");
-
-    if (!shared_memory.create(sizeof(server_data_t)))
-    {
-        shared_memory.attach();
-    }    
-
     sim_client = Q_NULLPTR;
 }
 
@@ -56,8 +65,7 @@ Model::Model(QObject *parent) : QObject(parent)
 //------------------------------------------------------------------------------
 Model::~Model()
 {
-    shared_memory.detach();
-    keys_data.detach();
+    legacy_feedback.stop();
 }
 
 //------------------------------------------------------------------------------
@@ -68,6 +76,11 @@ bool Model::init(const simulator_command_line_t &command_line)
     // Check is debug print allowed
     is_debug_print = command_line.debug_print.is_present;
 
+    is_batch_mode = command_line.batch_mode.is_present;
+
+    if (command_line.batch_output.is_present)
+        batch_output = command_line.batch_output.value;
+
     init_data_t init_data;
 
     // Load initial data configuration
@@ -101,6 +114,13 @@ bool Model::init(const simulator_command_line_t &command_line)
         Journal::instance()->warning("Profile is't loaded. Using flat profile");
     }
 
+    // Profile search is replaced by index computation in grid table
+    if (profile->isReady() && init_data.profile_grid &&
+        !profile->buildGrid(init_data.prof_step, init_data.profile_interpolation))
+    {
+        Journal::instance()->warning(QString("Profile grid table isn't built with step %1 m").arg(init_data.prof_step));
+    }
+
     // Train creation and initialization
     Journal::instance()->info("==== Train initialization ====");
     train = new Train(profile);
@@ -113,22 +133,57 @@ bool Model::init(const simulator_command_line_t &command_line)
     if (!train->init(init_data))
         return false;    
 
-    connect(this, &Model::sendDataToTrain, train, &Train::sendDataToVehicle);
+    // All configs are loaded, parsed documents aren't needed any more
+    CfgReader::clearCache();
 
-    keys_data.setKey("keys");    
+    train->setKeysState(&keys_state);
 
-    if (!keys_data.create(init_data.keys_buffer_size))
+    if (is_batch_mode)
     {
-        if (!keys_data.attach())
+        FileSystem &fs = FileSystem::getInstance();
+        QString cfg_path = QString(fs.getConfigDir().c_str()) + fs.separator() + "batch.xml";
+
+        if (!batch_writer.init(cfg_path, batch_output, train->getVehicles()))
+            return false;
+
+        if (command_line.control_script.is_present &&
+            !control_script.load(command_line.control_script.value))
         {
-            Journal::instance()->error("Can't attach to shread memory. Unable process keyboard");
+            return false;
         }
+
+        Journal::instance()->info("Train is initialized successfully for batch simulation");
+
+        return true;
     }
-    else
+
+    keys_reader.init(init_data.keys_buffer_size);
+
+    feedback_publisher.init(telemetry.getMaxSize(train->getVehiclesNumber()));
+
+    // Old viewers get fixed structure, restored from lock-free segment
+    // in separate thread, so simulation never waits for viewer's lock
+    if (is_legacy_feedback && feedback_publisher.isReady())
     {
-        Journal::instance()->info("Created shared memory for keysboard processing");
+        unsigned long interval = static_cast<unsigned long>(std::max(feedback_delay * 1000.0, 1.0));
+
+        if (legacy_feedback.init(feedback_publisher.getSegment(),
+                                 feedback_publisher.getCapacity(),
+                                 interval))
+        {
+            legacy_feedback.start();
+        }
     }
 
+    // First feedback is published on first step
+    feedback_time = feedback_delay;
+
+    deadline_monitor.init(static_cast<double>(integration_time_interval) / 1000.0,
+                          deadline_policy,
+                          deadline_catchup_limit);
+
+    initServer();
+
     initControlPanel("control-panel");
 
     initSimClient("virtual-railway");
@@ -162,6 +217,80 @@ bool Model::isStarted() const
     return is_simulation_started;
 }
 
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool Model::isBatchMode() const
+{
+    return is_batch_mode;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool Model::runBatch()
+{
+    if (!is_batch_mode || isStarted())
+        return false;
+
+    is_simulation_started = true;
+    t = start_time;
+
+    Journal::instance()->info(QString("Batch simulation from %1 to %2 s").arg(start_time).arg(stop_time));
+
+    QElapsedTimer wall_timer;
+    wall_timer.start();
+
+    double tau = 0;
+    double integration_time = static_cast<double>(integration_time_interval) / 1000.0;
+
+    batch_writer.write(t);
+
+    while ( (t < stop_time) && is_step_correct )
+    {
+        control_script.step(t, keys_state);
+
+        preStep(t);
+
+        is_step_correct = step(t, dt);
+
+        tau += dt;
+        t += dt;
+
+        postStep(t);
+
+        batch_writer.write(t);
+
+        // Vehicles input is processed at the same model time rate,
+        // as in real time simulation
+        if (tau >= integration_time)
+        {
+            tau = 0;
+            train->inputProcess();
+
+            if (is_debug_print)
+                debugPrint();
+        }
+    }
+
+    batch_writer.close();
+
+    // Final profiler report for whole run
+    profilerStep(profiler_dump_delay);
+
+    double wall_time = static_cast<double>(wall_timer.elapsed()) / 1000.0;
+
+    Journal::instance()->info(QString("Batch simulation finished at t = %1 s, wall time %2 s, %3 rows written")
+                              .arg(t)
+                              .arg(wall_time)
+                              .arg(batch_writer.getRowsCount()));
+
+    if (!is_step_correct)
+        Journal::instance()->error(QString("Integration failed at t = %1 s").arg(t));
+
+    return is_step_correct;
+}
+
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
@@ -259,6 +388,16 @@ void Model::loadInitData(init_data_t &init_data)
             init_data.prof_step = 100.0;
         }
 
+        if (!cfg.getBool(secName, "ProfileGrid", init_data.profile_grid))
+        {
+            init_data.profile_grid = false;
+        }
+
+        if (!cfg.getBool(secName, "ProfileInterpolation", init_data.profile_interpolation))
+        {
+            init_data.profile_interpolation = true;
+        }
+
         if (!cfg.getString(secName, "TrainConfig", init_data.train_config))
         {
             init_data.train_config = "default-train";
@@ -276,6 +415,103 @@ void Model::loadInitData(init_data_t &init_data)
 
         control_delay = static_cast<double>(init_data.control_time_interval) / 1000.0;
 
+        if (!cfg.getInt(secName, "FeedbackTimeInterval", init_data.feedback_time_interval))
+        {
+            init_data.feedback_time_interval = 20;
+        }
+
+        feedback_delay = static_cast<double>(init_data.feedback_time_interval) / 1000.0;
+
+        if (!cfg.getBool(secName, "LegacyFeedback", init_data.legacy_feedback))
+        {
+            init_data.legacy_feedback = true;
+        }
+
+        is_legacy_feedback = init_data.legacy_feedback;
+
+        if (!cfg.getInt(secName, "ProfilerDumpInterval", init_data.profiler_dump_interval))
+        {
+            init_data.profiler_dump_interval = 10000;
+        }
+
+        profiler_dump_delay = static_cast<double>(init_data.profiler_dump_interval) / 1000.0;
+
+        if (!cfg.getString(secName, "DeadlinePolicy", init_data.deadline_policy))
+        {
+            init_data.deadline_policy = "none";
+        }
+
+        if (!DeadlineMonitor::policyFromString(init_data.deadline_policy, deadline_policy))
+        {
+            Journal::instance()->warning("Unknown deadline policy " + init_data.deadline_policy);
+            deadline_policy = DEADLINE_POLICY_NONE;
+        }
+
+        if (!cfg.getDouble(secName, "DeadlineCatchUpLimit", init_data.deadline_catchup_limit))
+        {
+            init_data.deadline_catchup_limit = 2.0;
+        }
+
+        deadline_catchup_limit = init_data.deadline_catchup_limit;
+
+        if (!cfg.getInt(secName, "DeadlineReportInterval", init_data.deadline_report_interval))
+        {
+            init_data.deadline_report_interval = 1000;
+        }
+
+        deadline_report_delay = static_cast<double>(init_data.deadline_report_interval) / 1000.0;
+
+        if (!cfg.getInt(secName, "ServerPort", init_data.server_port))
+        {
+            init_data.server_port = 0;
+        }
+
+        server_port = init_data.server_port;
+
+        if (!cfg.getInt(secName, "SchedulerSpinTime", init_data.scheduler_spin_time))
+        {
+            init_data.scheduler_spin_time = 200;
+        }
+
+        if (!cfg.getInt(secName, "SchedulerEventsInterval", init_data.scheduler_events_interval))
+        {
+            init_data.scheduler_events_interval = 1000;
+        }
+
+        if (!cfg.getInt(secName, "SchedulerCpu", init_data.scheduler_cpu))
+        {
+            init_data.scheduler_cpu = -1;
+        }
+
+        if (!cfg.getInt(secName, "SchedulerPriority", init_data.scheduler_priority))
+        {
+            init_data.scheduler_priority = 0;
+        }
+
+        simTimer.setSpinTime(static_cast<quint64>(std::max(init_data.scheduler_spin_time, 0)));
+        simTimer.setEventsInterval(static_cast<quint64>(std::max(init_data.scheduler_events_interval, 1)));
+        simTimer.setCpu(init_data.scheduler_cpu);
+        simTimer.setRealtimePriority(init_data.scheduler_priority);
+
+        if (!cfg.getInt(secName, "TelemetryAnalogSignals", init_data.telemetry_analog_signals))
+        {
+            init_data.telemetry_analog_signals = MAX_ANALOG_SIGNALS;
+        }
+
+        if (!cfg.getInt(secName, "TelemetryDiscreteSignals", init_data.telemetry_discrete_signals))
+        {
+            init_data.telemetry_discrete_signals = MAX_DISCRETE_SIGNALS;
+        }
+
+        if (!cfg.getBool(secName, "TelemetryDebug", init_data.telemetry_debug))
+        {
+            init_data.telemetry_debug = true;
+        }
+
+        telemetry.setSignals(static_cast<size_t>(std::max(init_data.telemetry_analog_signals, 0)),
+                             static_cast<size_t>(std::max(init_data.telemetry_discrete_signals, 0)),
+                             init_data.telemetry_debug);
+
         if (!cfg.getBool(secName, "DebugPrint", init_data.debug_print))
         {
             init_data.debug_print = false;
@@ -317,6 +553,16 @@ void Model::overrideByCommandLine(init_data_t &init_data,
     if (command_line.direction.is_present)
         init_data.direction = command_line.direction.value;
 
+    if (command_line.init_velocity.is_present)
+        init_data.init_velocity = command_line.init_velocity.value;
+
+    if (command_line.payload_coeff.is_present)
+        init_data.payload_coeff = command_line.payload_coeff.value;
+
+    // Nobody listens in batch mode
+    if (command_line.batch_mode.is_present)
+        init_data.sound_enabled = false;
+
     Journal::instance()->info("Apply command line settinds");
 }
 
@@ -367,6 +613,20 @@ void Model::configSolver(solver_config_t &solver_config)
         }
 
         Journal::instance()->info("Maximal integration step: " + QString("%1").arg(solver_config.max_step));
+
+        if (!cfg.getDouble(secName, "BrakepipeStep", solver_config.brakepipe_step))
+        {
+            solver_config.brakepipe_step = 0.0;
+        }
+
+        Journal::instance()->info("Brakepipe integration step: " + QString("%1").arg(solver_config.brakepipe_step));
+
+        if (!cfg.getDouble(secName, "VehiclesStep", solver_config.vehicles_step))
+        {
+            solver_config.vehicles_step = 0.0;
+        }
+
+        Journal::instance()->info("Vehicles integration step: " + QString("%1").arg(solver_config.vehicles_step));
     }
     else
     {
@@ -483,42 +743,31 @@ void Model::initSimClient(QString cfg_path)
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
-void Model::tcpFeedBack()
+void Model::initServer()
 {
-    /*std::vector<Vehicle *> *vehicles = train->getVehicles();
-
-    viewer_data.time = static_cast<float>(integration_time_interval) / 1000.0f;
-
-    size_t i = 0;
-    for (auto it = vehicles->begin(); it != vehicles->end(); ++it)
-    {
-        viewer_data.te[i].coord = static_cast<float>((*it)->getRailwayCoord());
-        viewer_data.te[i].velocity = static_cast<float>((*it)->getVelocity());
-        viewer_data.te[i].coord_end = viewer_data.te[i].coord + viewer_data.te[i].velocity * viewer_data.time;
-
-        viewer_data.te[i].angle = static_cast<float>((*it)->getWheelAngle(0));
-        viewer_data.te[i].omega = static_cast<float>((*it)->getWheelOmega(0));
-        viewer_data.te[i].angle_end = viewer_data.te[i].angle + viewer_data.te[i].omega * viewer_data.time;
-
-        (*it)->getDebugMsg().toWCharArray(viewer_data.te[i].DebugMsg);
+    if (server_port <= 0)
+        return;
 
-        memcpy(viewer_data.te[i].discreteSignal,
-               (*it)->getDiscreteSignals(),
-               sizeof (viewer_data.te[i].discreteSignal));
+    server = new Server(this);
 
-        memcpy(viewer_data.te[i].analogSignal,
-               (*it)->getAnalogSignals(),
-               sizeof (viewer_data.te[i].analogSignal));
-        ++i;
-    }
+    connect(server, &Server::logMessage, this, &Model::logMessage);
+    connect(this, &Model::sendDataToServer, server, &Server::sendDataToClient);
+    connect(this, &Model::sendDeadlineStats, server, &Server::sendStatsToClient);
 
-    QByteArray array(sizeof(server_data_t), Qt::Uninitialized);
-    memcpy(array.data(), &viewer_data, sizeof(server_data_t));
-    emit sendDataToServer(array);
+    server->init(static_cast<quint16>(server_port));
+}
 
-    viewer_data.count++;
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Model::tcpFeedBack()
+{
+    // TCP clients get the same compact packet as shared memory readers.
+    // Packet is copied: client keeps sent buffer, and sharing of writer's
+    // buffer would make next write reallocate it
+    const QByteArray &packet = telemetry.getPacket();
 
-    emit sendDataToTrain(server->getReceivedData());*/
+    emit sendDataToServer(QByteArray(packet.constData(), packet.size()));
 }
 
 //------------------------------------------------------------------------------
@@ -558,64 +807,110 @@ void Model::virtualRailwayFeedback()
 //------------------------------------------------------------------------------
 void Model::sharedMemoryFeedback()
 {
-    std::vector<Vehicle *> *vehicles = train->getVehicles();
+    PROFILE_SCOPE(PROF_FEEDBACK);
 
-    viewer_data.time = static_cast<float>(t);
+    const QByteArray &packet = telemetry.write(*train->getVehicles(),
+                                               static_cast<float>(t),
+                                               viewer_data.count);
 
-    size_t i = 0;
+    feedback_publisher.publish(packet.constData(), static_cast<size_t>(packet.size()));
 
-    for (auto it = vehicles->begin(); it != vehicles->end(); ++it)
+    viewer_data.count++;    
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Model::controlStep(double &control_time, const double control_delay)
+{
+    if (control_time >= control_delay)
     {
-        viewer_data.te[i].coord = static_cast<float>((*it)->getRailwayCoord());
-        viewer_data.te[i].velocity = static_cast<float>((*it)->getVelocity());
+        PROFILE_SCOPE(PROF_CONTROL);
 
-        viewer_data.te[i].angle = static_cast<float>((*it)->getWheelAngle(0));
-        viewer_data.te[i].omega = static_cast<float>((*it)->getWheelOmega(0));
+        control_time = 0;
 
-        (*it)->getDebugMsg().toWCharArray(viewer_data.te[i].DebugMsg);        
+        keys_reader.read(keys_state);
+    }
 
-        /*std::copy((*it)->getDiscreteSignals().begin(),
-                  (*it)->getDiscreteSignals().end(),
-                  viewer_data.te[i].discreteSignal.begin());*/
+    control_time += dt;
+}
 
-        std::copy((*it)->getAnalogSignals().begin(),
-                  (*it)->getAnalogSignals().end(),
-                  viewer_data.te[i].analogSignal.begin());
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Model::feedbackStep(double &feedback_time, const double feedback_delay)
+{
+    if (feedback_time >= feedback_delay * deadline_monitor.getOutputDivider())
+    {
+        feedback_time = 0;
 
-        ++i;
-    }
+        if (deadline_monitor.isOutputAllowed())
+        {
+            sharedMemoryFeedback();
 
-    if (shared_memory.lock())
-    {
-        memcpy(shared_memory.data(), &viewer_data, sizeof (server_data_t));
-        shared_memory.unlock();
+            // Same packet is streamed (delta-encoded) to TCP clients
+            if (server != nullptr)
+                tcpFeedBack();
+        }
+        else
+        {
+            deadline_monitor.skipOutput();
+        }
     }
 
-    viewer_data.count++;    
+    feedback_time += dt;
 }
 
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
-void Model::controlStep(double &control_time, const double control_delay)
+void Model::profilerStep(double elapsed)
 {
-    if (control_time >= control_delay)
-    {
-        control_time = 0;
+#if defined(STEP_PROFILER)
+    profiler_dump_time += elapsed;
+
+    if (profiler_dump_time < profiler_dump_delay)
+        return;
 
-        if (keys_data.lock())
-        {            
-            data.resize(keys_data.size());
-            memcpy(data.data(), keys_data.data(), static_cast<size_t>(keys_data.size()));
+    profiler_dump_time = 0;
 
-            if (keys_data.size() != 0)
-                emit sendDataToTrain(data);
+    FileSystem &fs = FileSystem::getInstance();
+    QString path = QString(fs.combinePath(fs.getLogsDir(), "profiler.log").c_str());
 
-            keys_data.unlock();
-        }
+    if (!StepProfiler::dump(path))
+        Journal::instance()->error("Can't write profiler report into " + path);
+#else
+    Q_UNUSED(elapsed)
+#endif
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Model::deadlineStep(double elapsed)
+{
+    deadline_report_time += elapsed;
+
+    if (deadline_report_time < deadline_report_delay)
+        return;
+
+    deadline_report_time = 0;
+
+    deadline_stats_t stats = deadline_monitor.takeStats();
+
+    if (stats.overruns > deadline_overruns)
+    {
+        Journal::instance()->warning(QString("Deadline overruns: %1 (total %2), jitter p99 %3 ms, real time factor %4")
+                                     .arg(stats.overruns - deadline_overruns)
+                                     .arg(stats.overruns)
+                                     .arg(static_cast<double>(stats.jitter_p99))
+                                     .arg(static_cast<double>(stats.realtime_factor)));
     }
 
-    control_time += dt;
+    deadline_overruns = stats.overruns;
+
+    QByteArray data(reinterpret_cast<const char *>(&stats), sizeof(deadline_stats_t));
+    emit sendDeadlineStats(data);
 }
 
 //------------------------------------------------------------------------------
@@ -624,28 +919,40 @@ void Model::controlStep(double &control_time, const double control_delay)
 void Model::process()
 {
     double tau = 0;
-    double integration_time = static_cast<double>(integration_time_interval) / 1000.0;    
+    // Model time of this tick, including catch-up of lag
+    double integration_time = deadline_monitor.beginTick();
 
-    // Integrate all ODE in train motion model
-    while ( (tau <= integration_time) &&
-            is_step_correct)
     {
-        preStep(t);
+        PROFILE_SCOPE(PROF_MODEL_PROCESS);
 
-        // Feedback to viewer
-        sharedMemoryFeedback();
+        // Integrate all ODE in train motion model
+        while ( (tau <= integration_time) &&
+                is_step_correct)
+        {
+            preStep(t);
 
-        controlStep(control_time, control_delay);
+            // Feedback to viewer, once per publishing interval
+            feedbackStep(feedback_time, feedback_delay);
 
-        is_step_correct = step(t, dt);
+            controlStep(control_time, control_delay);
 
-        tau += dt;
-        t += dt;
+            is_step_correct = step(t, dt);
 
-        postStep(t);
+            tau += dt;
+            t += dt;
+
+            postStep(t);
+        }
+
+        PROFILE_SCOPE(PROF_INPUT);
+        train->inputProcess();
     }
 
-    train->inputProcess();    
+    deadline_monitor.endTick(tau);
+
+    deadlineStep(tau);
+
+    profilerStep(tau);
 
     // Debug print, is allowed
     if (is_debug_print)
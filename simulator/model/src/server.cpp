@@ -82,6 +82,17 @@ void Server::sendDataToClient(QByteArray data)
     }
 }
 
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Server::sendStatsToClient(QByteArray data)
+{
+    if (monitor.client)
+    {
+        monitor.client->setOutputBuffer(data);
+    }
+}
+
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
@@ -95,6 +106,12 @@ void Server::clientAuthorized(ClientFace *clnt)
         clients.client->setOutputBuffer(QString("Hello").toUtf8());
         emit logMessage("OK: Authorized client: " + clientName);
     }
+
+    if (clientName == "monitor")
+    {
+        monitor.client = clnt;
+        emit logMessage("OK: Authorized client: " + clientName);
+    }
 }
 
 //------------------------------------------------------------------------------
@@ -107,4 +124,10 @@ void Server::clientDisconnected(ClientFace *clnt)
         emit logMessage("OK: Disconnected client: " + clnt->getName());
         clients.client = Q_NULLPTR;
     }
+
+    if (clnt == monitor.client)
+    {
+        emit logMessage("OK: Disconnected client: " + clnt->getName());
+        monitor.client = Q_NULLPTR;
+    }
 }
@@ -0,0 +1,235 @@
+//------------------------------------------------------------------------------
+//
+//      Delta encoding of telemetry stream
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Delta encoding of telemetry stream
+ * \copyright maisvendoo
+ */
+
+#include    "telemetry-delta.h"
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+TelemetryDeltaEncoder::TelemetryDeltaEncoder()
+    : sequence(0)
+    , keyframe_interval(50)
+    , packets_count(0)
+    , is_keyframe_required(true)
+    , vehicles_num(0)
+    , analog_num(0)
+    , discrete_num(0)
+    , signal_sets(0)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+TelemetryDeltaEncoder::~TelemetryDeltaEncoder()
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void TelemetryDeltaEncoder::setKeyframeInterval(int interval)
+{
+    keyframe_interval = std::max(interval, 1);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void TelemetryDeltaEncoder::reset()
+{
+    is_keyframe_required = true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+QByteArray TelemetryDeltaEncoder::encode(const QByteArray &packet)
+{
+    size_t size = static_cast<size_t>(packet.size());
+
+    if (size < sizeof(telemetry_header_t))
+        return packet;
+
+    telemetry_header_t header;
+    memcpy(&header, packet.constData(), sizeof(header));
+
+    if ( (header.magic != TELEMETRY_MAGIC) ||
+         (header.version != TELEMETRY_VERSION) ||
+         (header.signal_sets & (TELEMETRY_DELTA | TELEMETRY_KEYFRAME)) ||
+         (header.packet_size > size) )
+    {
+        return packet;
+    }
+
+    size_t n = header.vehicles_num;
+    size_t an = header.analog_num;
+    size_t dn = header.discrete_num;
+
+    const char *begin = packet.constData();
+    const char *kinematics = begin + header.header_size;
+    const char *analog_block = kinematics;
+
+    if (header.signal_sets & TELEMETRY_KINEMATICS)
+        analog_block += n * sizeof(telemetry_kinematics_t);
+
+    const char *discrete_block = analog_block;
+
+    if (header.signal_sets & TELEMETRY_ANALOG)
+        discrete_block += n * an * sizeof(float);
+
+    const char *debug_block = discrete_block;
+
+    if (header.signal_sets & TELEMETRY_DISCRETE)
+        debug_block += n * telemetryDiscreteBytes(dn);
+
+    if (debug_block > begin + header.packet_size)
+        return packet;
+
+    const char *end = begin + header.packet_size;
+
+    bool is_layout_changed = (n != vehicles_num) || (an != analog_num) ||
+            (dn != discrete_num) || (header.signal_sets != signal_sets);
+
+    header.sequence = ++sequence;
+
+    // Keyframe is full packet itself
+    if (is_keyframe_required || is_layout_changed ||
+        (packets_count >= keyframe_interval - 1))
+    {
+        vehicles_num = n;
+        analog_num = an;
+        discrete_num = dn;
+        signal_sets = header.signal_sets;
+
+        storeSignals(analog_block, discrete_block);
+
+        header.signal_sets |= TELEMETRY_KEYFRAME;
+
+        out = packet;
+        out.resize(static_cast<int>(header.packet_size));
+        memcpy(out.data(), &header, sizeof(header));
+
+        is_keyframe_required = false;
+        packets_count = 0;
+
+        return out;
+    }
+
+    packets_count++;
+
+    size_t vehicles_bytes = telemetryMaskBytes(n);
+    size_t analog_bytes = telemetryMaskBytes(an);
+    size_t discrete_bytes = telemetryDiscreteBytes(dn);
+
+    // Delta packet is never greater than full packet and masks
+    size_t max_size = header.packet_size + 2 * vehicles_bytes + n * analog_bytes;
+
+    if (static_cast<size_t>(out.size()) < max_size)
+        out.resize(static_cast<int>(max_size));
+
+    char *dst = out.data() + header.header_size;
+
+    memcpy(dst, kinematics, static_cast<size_t>(analog_block - kinematics));
+    dst += analog_block - kinematics;
+
+    if (header.signal_sets & TELEMETRY_ANALOG)
+    {
+        quint8 *vmask = reinterpret_cast<quint8 *>(dst);
+        memset(vmask, 0, vehicles_bytes);
+        dst += vehicles_bytes;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            const char *values = analog_block + i * an * sizeof(float);
+            float *prev = analog.data() + i * an;
+
+            // Bitwise comparison, so NaN values are transferred once too
+            if (memcmp(values, prev, an * sizeof(float)) == 0)
+                continue;
+
+            vmask[i / 8] |= static_cast<quint8>(1 << (i % 8));
+
+            quint8 *smask = reinterpret_cast<quint8 *>(dst);
+            memset(smask, 0, analog_bytes);
+            dst += analog_bytes;
+
+            for (size_t j = 0; j < an; ++j)
+            {
+                if (memcmp(values + j * sizeof(float), prev + j, sizeof(float)) == 0)
+                    continue;
+
+                smask[j / 8] |= static_cast<quint8>(1 << (j % 8));
+
+                memcpy(dst, values + j * sizeof(float), sizeof(float));
+                memcpy(prev + j, values + j * sizeof(float), sizeof(float));
+                dst += sizeof(float);
+            }
+        }
+    }
+
+    if (header.signal_sets & TELEMETRY_DISCRETE)
+    {
+        quint8 *vmask = reinterpret_cast<quint8 *>(dst);
+        memset(vmask, 0, vehicles_bytes);
+        dst += vehicles_bytes;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            const quint8 *bits = reinterpret_cast<const quint8 *>(discrete_block) +
+                    i * discrete_bytes;
+            quint8 *prev = discrete.data() + i * discrete_bytes;
+
+            if (memcmp(bits, prev, discrete_bytes) == 0)
+                continue;
+
+            vmask[i / 8] |= static_cast<quint8>(1 << (i % 8));
+
+            for (size_t k = 0; k < discrete_bytes; ++k)
+            {
+                dst[k] = static_cast<char>(bits[k] ^ prev[k]);
+                prev[k] = bits[k];
+            }
+
+            dst += discrete_bytes;
+        }
+    }
+
+    // Debug records are copied as is
+    memcpy(dst, debug_block, static_cast<size_t>(end - debug_block));
+    dst += end - debug_block;
+
+    header.signal_sets |= TELEMETRY_DELTA;
+    header.packet_size = static_cast<quint32>(dst - out.data());
+    memcpy(out.data(), &header, sizeof(header));
+
+    out.resize(static_cast<int>(header.packet_size));
+
+    return out;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void TelemetryDeltaEncoder::storeSignals(const char *analog_block, const char *discrete_block)
+{
+    analog.resize(vehicles_num * analog_num);
+    discrete.resize(vehicles_num * telemetryDiscreteBytes(discrete_num));
+
+    if (signal_sets & TELEMETRY_ANALOG)
+        memcpy(analog.data(), analog_block, analog.size() * sizeof(float));
+
+    if (signal_sets & TELEMETRY_DISCRETE)
+        memcpy(discrete.data(), discrete_block, discrete.size());
+}
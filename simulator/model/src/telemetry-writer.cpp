@@ -0,0 +1,179 @@
+//------------------------------------------------------------------------------
+//
+//      Compact telemetry packet writer
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Compact telemetry packet writer
+ * \copyright maisvendoo
+ */
+
+#include    "telemetry-writer.h"
+
+#include    "vehicle.h"
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+TelemetryWriter::TelemetryWriter()
+    : analog_num(MAX_ANALOG_SIGNALS)
+    , discrete_num(MAX_DISCRETE_SIGNALS)
+    , is_debug(true)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+TelemetryWriter::~TelemetryWriter()
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void TelemetryWriter::setSignals(size_t analog_num, size_t discrete_num, bool is_debug)
+{
+    this->analog_num = static_cast<quint16>(std::min(analog_num,
+                                                     static_cast<size_t>(MAX_ANALOG_SIGNALS)));
+
+    this->discrete_num = static_cast<quint16>(std::min(discrete_num,
+                                                       static_cast<size_t>(MAX_DISCRETE_SIGNALS)));
+
+    this->is_debug = is_debug;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+size_t TelemetryWriter::getMaxSize(size_t vehicles_num) const
+{
+    return telemetryMaxSize(vehicles_num, analog_num, discrete_num, is_debug);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const QByteArray &TelemetryWriter::write(const std::vector<Vehicle *> &vehicles,
+                                         float time,
+                                         quint64 count,
+                                         quint32 route_id)
+{
+    size_t n = std::min(vehicles.size(), static_cast<size_t>(MAX_NUM_VEHICLES));
+    size_t max_size = getMaxSize(n);
+
+    if (static_cast<size_t>(packet.size()) < max_size)
+        packet.resize(static_cast<int>(max_size));
+
+    char *begin = packet.data();
+    char *ptr = begin + sizeof(telemetry_header_t);
+
+    telemetry_header_t header;
+
+    header.magic = TELEMETRY_MAGIC;
+    header.version = TELEMETRY_VERSION;
+    header.header_size = sizeof(telemetry_header_t);
+    header.route_id = route_id;
+    header.count = count;
+    header.sequence = static_cast<quint32>(count);
+    header.time = time;
+    header.vehicles_num = static_cast<quint16>(n);
+    header.signal_sets = TELEMETRY_KINEMATICS;
+    header.analog_num = analog_num;
+    header.discrete_num = discrete_num;
+    header.debug_num = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        telemetry_kinematics_t k;
+
+        k.coord = static_cast<float>(vehicles[i]->getRailwayCoord());
+        k.velocity = static_cast<float>(vehicles[i]->getVelocity());
+        k.angle = static_cast<float>(vehicles[i]->getWheelAngle(0));
+        k.omega = static_cast<float>(vehicles[i]->getWheelOmega(0));
+
+        memcpy(ptr, &k, sizeof(k));
+        ptr += sizeof(k);
+    }
+
+    if (analog_num > 0)
+    {
+        header.signal_sets |= TELEMETRY_ANALOG;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            std::array<float, MAX_ANALOG_SIGNALS> analog = vehicles[i]->getAnalogSignals();
+
+            memcpy(ptr, analog.data(), analog_num * sizeof(float));
+            ptr += analog_num * sizeof(float);
+        }
+    }
+
+    if (discrete_num > 0)
+    {
+        header.signal_sets |= TELEMETRY_DISCRETE;
+
+        size_t discrete_bytes = telemetryDiscreteBytes(discrete_num);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            std::array<bool, MAX_DISCRETE_SIGNALS> discrete = vehicles[i]->getDiscreteSignals();
+
+            quint8 *bits = reinterpret_cast<quint8 *>(ptr);
+            memset(bits, 0, discrete_bytes);
+
+            for (size_t j = 0; j < discrete_num; ++j)
+                bits[j / 8] |= static_cast<quint8>(discrete[j]) << (j % 8);
+
+            ptr += discrete_bytes;
+        }
+    }
+
+    if (is_debug)
+    {
+        header.signal_sets |= TELEMETRY_DEBUG;
+
+        // Only not empty strings are written
+        for (size_t i = 0; i < n; ++i)
+        {
+            QString msg = vehicles[i]->getDebugMsg();
+
+            if (msg.isEmpty())
+                continue;
+
+            QByteArray utf8 = msg.left(DEBUG_STRING_SIZE - 1).toUtf8();
+
+            telemetry_debug_t rec;
+            rec.vehicle = static_cast<quint16>(i);
+            rec.size = static_cast<quint16>(utf8.size());
+
+            memcpy(ptr, &rec, sizeof(rec));
+            ptr += sizeof(rec);
+
+            memcpy(ptr, utf8.constData(), rec.size);
+            ptr += rec.size;
+
+            header.debug_num++;
+        }
+    }
+
+    header.packet_size = static_cast<quint32>(ptr - begin);
+    memcpy(begin, &header, sizeof(header));
+
+    // Capacity is kept by shrinking, while packet isn't shared
+    packet.resize(static_cast<int>(header.packet_size));
+
+    return packet;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const QByteArray &TelemetryWriter::getPacket() const
+{
+    return packet;
+}
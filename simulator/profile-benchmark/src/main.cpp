@@ -0,0 +1,219 @@
+//------------------------------------------------------------------------------
+//
+//      Benchmark of route profile lookup
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Benchmark of route profile lookup
+ * \copyright maisvendoo
+ *
+ * Generated 500 km route is loaded by Profile. Train of 60 vehicles runs
+ * along it, and each step every vehicle looks up its profile element, as
+ * Train::calcDerivative does. Lookup with hint is compared with previous
+ * implementation (binary search over profile_element_t array, bounds
+ * checked access), both for time and for found elements
+ */
+
+#include    <QCoreApplication>
+#include    <QTemporaryDir>
+#include    <QFile>
+
+#include    <chrono>
+#include    <cstdio>
+#include    <sstream>
+#include    <string>
+#include    <vector>
+
+#include    "profile.h"
+
+//------------------------------------------------------------------------------
+//  Previous implementation of Profile::getElement()
+//------------------------------------------------------------------------------
+static profile_element_t oldGetElement(const std::vector<profile_element_t> &profile_data,
+                                       int dir,
+                                       double railway_coord)
+{
+    if (profile_data.size() == 0)
+        return profile_element_t();
+
+    if (railway_coord < (*profile_data.begin()).railway_coord)
+        return profile_element_t();
+
+    if (railway_coord >= (*(profile_data.end() - 1)).railway_coord)
+        return profile_element_t();
+
+    profile_element_t profile_element;
+
+    size_t left_idx = 0;
+    size_t right_idx = profile_data.size() - 1;
+    size_t idx = (left_idx + right_idx) / 2;
+
+    while (idx != left_idx)
+    {
+        profile_element = profile_data.at(idx);
+
+        if (railway_coord <= profile_element.railway_coord)
+            right_idx = idx;
+        else
+            left_idx = idx;
+
+        idx = (left_idx + right_idx) / 2;
+    }
+
+    profile_element = profile_data.at(idx);
+    profile_element.inclination *= dir;
+
+    return profile_element;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static bool isEqual(const profile_element_t &a, const profile_element_t &b)
+{
+    return (a.railway_coord == b.railway_coord) &&
+           (a.inclination == b.inclination) &&
+           (a.curvature == b.curvature);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static std::string generateProfile(double length, std::vector<profile_element_t> &profile_data)
+{
+    std::string text;
+    double x = 0;
+    unsigned int seed = 12345;
+
+    // Elements from 40 to 200 m
+    while (true)
+    {
+        seed = seed * 1103515245 + 12345;
+
+        char line[64];
+
+        snprintf(line, sizeof(line), "%.4f %d %d\n",
+                 x / 1000.0,
+                 static_cast<int>(seed % 25) - 12,
+                 static_cast<int>((seed >> 8) % 3) * 600);
+
+        text += line;
+
+        // Element is parsed as Profile::load() does
+        profile_element_t element;
+        std::istringstream ss(line);
+
+        ss >> element.railway_coord
+           >> element.inclination
+           >> element.curvature;
+
+        element.railway_coord *= 1000.0;
+        profile_data.push_back(element);
+
+        if (x >= length)
+            break;
+
+        x += 40.0 + (seed >> 16) % 161;
+    }
+
+    return text;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    QTemporaryDir dir;
+
+    if (!dir.isValid())
+        return 1;
+
+    std::vector<profile_element_t> profile_data;
+    QFile file(dir.path() + "/profile1.conf");
+
+    if (!file.open(QFile::WriteOnly | QFile::Text))
+        return 1;
+
+    std::string text = generateProfile(500e3, profile_data);
+    file.write(text.c_str(), static_cast<qint64>(text.size()));
+    file.close();
+
+    Profile profile(1, dir.path().toStdString());
+
+    if (!profile.isReady())
+        return 1;
+
+    const size_t vehicles_num = 60;
+    const double vehicle_length = 15.0;
+    const double velocity = 30.0;
+    const double dt = 1e-3;
+    const int steps = 200000;
+
+    std::vector<size_t> hints(vehicles_num, 0);
+    size_t mismatches = 0;
+    double old_checksum = 0;
+    double new_checksum = 0;
+
+    // Lookup time
+    auto t0 = std::chrono::steady_clock::now();
+
+    for (int step = 0; step < steps; step++)
+    {
+        double x0 = 1000.0 + velocity * step * dt;
+
+        for (size_t i = 0; i < vehicles_num; i++)
+            old_checksum += oldGetElement(profile_data, 1, x0 - i * vehicle_length).inclination;
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    for (int step = 0; step < steps; step++)
+    {
+        double x0 = 1000.0 + velocity * step * dt;
+
+        for (size_t i = 0; i < vehicles_num; i++)
+            new_checksum += profile.getElement(x0 - i * vehicle_length, hints[i]).inclination;
+    }
+
+    auto t2 = std::chrono::steady_clock::now();
+
+    // Found elements along the whole route, with exact element boundaries
+    size_t hint = 0;
+
+    for (size_t i = 0; i < profile_data.size(); i++)
+    {
+        double x = profile_data[i].railway_coord;
+        double points[] = { x - 0.5, x, x + 0.5 };
+
+        for (double p : points)
+        {
+            profile_element_t element = oldGetElement(profile_data, 1, p);
+
+            if (!isEqual(element, profile.getElement(p, hint)))
+                mismatches++;
+
+            if (!isEqual(element, profile.getElement(p)))
+                mismatches++;
+        }
+    }
+
+    double lookups = static_cast<double>(steps) * vehicles_num;
+
+    fprintf(stdout, "route %.0f km, %zu elements, %.0f lookups\n",
+            profile_data.back().railway_coord / 1000.0, profile_data.size(), lookups);
+
+    fprintf(stdout, "old:  %6.1f ns/lookup  checksum %.9g\n",
+            std::chrono::duration<double, std::nano>(t1 - t0).count() / lookups, old_checksum);
+
+    fprintf(stdout, "hint: %6.1f ns/lookup  checksum %.9g\n",
+            std::chrono::duration<double, std::nano>(t2 - t1).count() / lookups, new_checksum);
+
+    fprintf(stdout, "mismatches: %zu\n", mismatches);
+
+    return (mismatches == 0) ? 0 : 1;
+}
@@ -0,0 +1,34 @@
+TEMPLATE = app
+
+QT -= gui
+QT += core
+
+CONFIG += c++11
+CONFIG += console
+CONFIG -= app_bundle
+
+DESTDIR += ../../../bin
+
+TARGET = profile-converter
+
+CONFIG(debug, debug|release) {
+
+    TARGET = $$join(TARGET,,,_d)
+
+    LIBS += -L../../../lib -lprofile_d
+    LIBS += -L../../../lib -lfilesystem_d
+    LIBS += -L../../../lib -lJournal_d
+
+} else {
+
+    LIBS += -L../../../lib -lprofile
+    LIBS += -L../../../lib -lfilesystem
+    LIBS += -L../../../lib -lJournal
+}
+
+INCLUDEPATH += ../../common-headers/
+INCLUDEPATH += ../profile/include
+INCLUDEPATH += ../../filesystem/include
+INCLUDEPATH += ../../libJournal/include
+
+SOURCES += $$files(./src/*.cpp)
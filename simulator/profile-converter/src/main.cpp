@@ -0,0 +1,87 @@
+//------------------------------------------------------------------------------
+//
+//      Converter of text route profiles into binary ones
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Converter of text route profiles into binary ones
+ * \copyright maisvendoo
+ */
+
+#include    <QCoreApplication>
+#include    <QCommandLineParser>
+#include    <QDir>
+#include    <QFileInfo>
+
+#include    "profile.h"
+#include    "filesystem.h"
+#include    "Journal.h"
+#include    "JournalFile.h"
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static bool convertProfile(const QString &text_path)
+{
+    std::string path = text_path.toStdString();
+    std::string binary_path = Profile::binaryPath(path);
+
+    bool is_converted = Profile::convert(path, binary_path);
+
+    fputs(qPrintable(QString("%1 -> %2: %3\n")
+                     .arg(text_path)
+                     .arg(binary_path.c_str())
+                     .arg(is_converted ? "OK" : "FAIL")), stdout);
+
+    return is_converted;
+}
+
+/*!
+ * \fn
+ * \brief Program entry point
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    FileSystem &fs = FileSystem::getInstance();
+    QString log_path = QString(fs.combinePath(fs.getLogsDir(), "profile-converter.log").c_str());
+    Journal::instance()->addStorage( new JournalFile(log_path, JournalLevel::All) );
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Converts profile1.conf and profile2.conf of route directory "
+                                     "(or given text profiles) into binary profiles");
+    parser.addHelpOption();
+    parser.addPositionalArgument("paths", QCoreApplication::translate("main", "Route directories or text profiles"));
+
+    parser.process(app);
+
+    if (parser.positionalArguments().isEmpty())
+        parser.showHelp(1);
+
+    bool is_ok = true;
+
+    for (const QString &path : parser.positionalArguments())
+    {
+        if (!QFileInfo(path).isDir())
+        {
+            is_ok = convertProfile(path) && is_ok;
+            continue;
+        }
+
+        QDir route_dir(path);
+
+        for (const QString &name : QStringList() << "profile1.conf" << "profile2.conf")
+        {
+            if (route_dir.exists(name))
+                is_ok = convertProfile(route_dir.filePath(name)) && is_ok;
+        }
+    }
+
+    return is_ok ? 0 : 1;
+}
@@ -0,0 +1,81 @@
+//------------------------------------------------------------------------------
+//
+//      Binary route profile format
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Binary route profile format
+ * \copyright maisvendoo
+ *
+ * File layout:
+ *
+ *  profile_binary_header_t
+ *  double  railway_coord   [count]     (m, sorted)
+ *  double  inclination     [count]     (per mille)
+ *  double  curvature       [count]
+ *
+ * Arrays follow header at offsets from header, aligned by 8 bytes, so file
+ * is used directly after memory mapping. Binary file is a cache of text
+ * profile: size and modification time of source file are stored in header
+ * and file is regenerated, when source file is changed
+ */
+
+#ifndef     PROFILE_BINARY_H
+#define     PROFILE_BINARY_H
+
+#include    <QtGlobal>
+
+/// File signature ("SIMP")
+#define     PROFILE_BINARY_MAGIC        0x504D4953u
+
+/// File layout version
+#define     PROFILE_BINARY_VERSION      1u
+
+/// Binary profile file extension
+#define     PROFILE_BINARY_EXT          ".bin"
+
+#pragma pack(push, 1)
+
+/*!
+ * \struct
+ * \brief Binary profile header
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct profile_binary_header_t
+{
+    quint32     magic;
+    quint32     version;
+    /// Number of profile elements
+    quint64     count;
+    /// Source text profile size (negative - no source)
+    qint64      source_size;
+    /// Source text profile modification time, ms since epoch
+    qint64      source_mtime;
+    /// Arrays offsets from file begin
+    quint64     coord_offset;
+    quint64     inclination_offset;
+    quint64     curvature_offset;
+    quint64     reserved;
+
+    profile_binary_header_t()
+        : magic(PROFILE_BINARY_MAGIC)
+        , version(PROFILE_BINARY_VERSION)
+        , count(0)
+        , source_size(-1)
+        , source_mtime(0)
+        , coord_offset(0)
+        , inclination_offset(0)
+        , curvature_offset(0)
+        , reserved(0)
+    {
+
+    }
+};
+
+#pragma pack(pop)
+
+#endif // PROFILE_BINARY_H
@@ -11,8 +11,12 @@
 #include    <fstream>
 #include    <vector>
 
+#include    <QtGlobal>
+
 #include    "profile-element.h"
 
+class QFile;
+
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
@@ -23,6 +27,15 @@ public:
     Profile()
         : is_ready(false)
         , dir(1)
+        , count(0)
+        , coord(nullptr)
+        , inclination(nullptr)
+        , curvature(nullptr)
+        , binary_file(nullptr)
+        , grid_begin(0.0)
+        , grid_inv_step(0.0)
+        , grid_step(0.0)
+        , is_grid_interpolated(false)
     {
 
     }
@@ -33,19 +46,89 @@ public:
 
     bool isReady() const;
 
-    profile_element_t getElement(double railway_coord);
+    profile_element_t getElement(double railway_coord) const;
+
+    /// Element search, started from hint (index of element, found by previous
+    /// call for the same vehicle). Hint is updated. Vehicle moves only a few
+    /// metres per step, so element is found in O(1) in common case
+    profile_element_t getElement(double railway_coord, size_t &hint) const;
+
+    /// Build uniform grid table with given step (m). Grid node holds profile
+    /// values, averaged over its cell. After that getElement() only computes
+    /// node index and (optionally) interpolates between nodes
+    bool buildGrid(double step, bool interpolate);
+
+    /// Convert text profile into binary one
+    static bool convert(const std::string &text_path, const std::string &binary_path);
+
+    /// Binary profile path for text profile path
+    static std::string binaryPath(const std::string &text_path);
 
 private:
 
+    /// Profile owns mapped file and points into own arrays
+    Q_DISABLE_COPY(Profile)
+
     bool    is_ready;
 
     int     dir;
 
-    std::vector<profile_element_t> profile_data;
+    /// Number of profile elements
+    size_t  count;
+
+    /// Profile arrays (mapped binary file or text profile data)
+    const double *coord;
+    const double *inclination;
+    const double *curvature;
+
+    /// Text profile data
+    std::vector<double> coord_data;
+    std::vector<double> inclination_data;
+    std::vector<double> curvature_data;
+
+    /// Mapped binary profile
+    QFile   *binary_file;
+
+    /// Grid table coordinate of first node
+    double  grid_begin;
+    /// Inverse grid step
+    double  grid_inv_step;
+    /// Grid step (zero - grid is not built)
+    double  grid_step;
+    /// Linear interpolation between grid nodes
+    bool    is_grid_interpolated;
+    /// Inclination in nodes (direction is applied)
+    std::vector<double> grid_inclination;
+    /// Curvature in nodes
+    std::vector<double> grid_curvature;
+
+    /// Element from grid table
+    profile_element_t gridElement(double railway_coord) const;
+
+    /// Average of piecewise constant profile values over [begin, end]
+    void average(double begin, double end, size_t &idx,
+                 double &avg_inclination, double &avg_curvature) const;
+
+    /// Index of element, railway_coord belongs to (binary search)
+    size_t findIndex(double railway_coord) const;
+
+    /// Check railway_coord belongs to element with index idx
+    bool isInElement(size_t idx, double railway_coord) const;
+
+    profile_element_t elementAt(size_t idx) const;
 
     bool load(const std::string &path);
 
     bool load(std::ifstream &stream);
+
+    /// Map binary profile, if it is up to date with text profile
+    bool loadBinary(const std::string &binary_path, const std::string &text_path);
+
+    /// Write loaded profile into binary file
+    bool saveBinary(const std::string &binary_path, const std::string &text_path) const;
+
+    /// Use owned text profile data
+    void setTextData();
 };
 
 #endif // PROFILE_H
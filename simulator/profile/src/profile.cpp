@@ -2,6 +2,16 @@
 
 #include    <iostream>
 #include    <sstream>
+#include    <cstring>
+#include    <algorithm>
+#include    <cmath>
+
+#include    <QFile>
+#include    <QFileInfo>
+#include    <QDateTime>
+#include    <QSaveFile>
+
+#include    "profile-binary.h"
 
 #include    "filesystem.h"
 #include    "Journal.h"
@@ -12,6 +22,15 @@
 Profile::Profile(int dir, const std::string &routeDir)
     : is_ready(false)
     , dir(dir)
+    , count(0)
+    , coord(nullptr)
+    , inclination(nullptr)
+    , curvature(nullptr)
+    , binary_file(nullptr)
+    , grid_begin(0.0)
+    , grid_inv_step(0.0)
+    , grid_step(0.0)
+    , is_grid_interpolated(false)
 {
     FileSystem &fs = FileSystem::getInstance();
     std::string path = fs.toNativeSeparators(routeDir);
@@ -37,7 +56,8 @@ Profile::Profile(int dir, const std::string &routeDir)
 //------------------------------------------------------------------------------
 Profile::~Profile()
 {
-
+    // Memory is unmapped, when file is destroyed
+    delete binary_file;
 }
 
 //------------------------------------------------------------------------------
@@ -51,28 +71,179 @@ bool Profile::isReady() const
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
-profile_element_t Profile::getElement(double railway_coord)
+profile_element_t Profile::getElement(double railway_coord) const
 {
-    if (profile_data.size() == 0)
+    size_t hint = 0;
+    return getElement(railway_coord, hint);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+profile_element_t Profile::getElement(double railway_coord, size_t &hint) const
+{
+    if (count == 0)
         return profile_element_t();
 
-    if (railway_coord < (*profile_data.begin()).railway_coord)
+    if (railway_coord < coord[0])
         return profile_element_t();
 
-    if (railway_coord >= (*(profile_data.end() - 1)).railway_coord)
+    if (railway_coord >= coord[count - 1])
         return profile_element_t();
 
+    if (grid_step > 0.0)
+        return gridElement(railway_coord);
+
+    size_t last = count - 2;
+
+    if (hint > last)
+        hint = last;
+
+    if (isInElement(hint, railway_coord))
+        return elementAt(hint);
+
+    // Vehicle has moved to neighbour element
+    if ( (hint < last) && isInElement(hint + 1, railway_coord) )
+    {
+        hint++;
+        return elementAt(hint);
+    }
+
+    if ( (hint > 0) && isInElement(hint - 1, railway_coord) )
+    {
+        hint--;
+        return elementAt(hint);
+    }
+
+    // Jump (initialization, coordinate reset), full search
+    hint = findIndex(railway_coord);
+
+    return elementAt(hint);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool Profile::buildGrid(double step, bool interpolate)
+{
+    if ( (step <= 0.0) || (count < 2) )
+        return false;
+
+    double begin = coord[0];
+    double end = coord[count - 1];
+
+    // Last node is not before profile end
+    size_t nodes = static_cast<size_t>(std::ceil((end - begin) / step)) + 1;
+
+    grid_inclination.resize(nodes);
+    grid_curvature.resize(nodes);
+
+    size_t idx = 0;
+
+    for (size_t k = 0; k < nodes; ++k)
+    {
+        double x = begin + static_cast<double>(k) * step;
+
+        average(std::max(x - step / 2, begin), std::min(x + step / 2, end),
+                idx, grid_inclination[k], grid_curvature[k]);
+
+        grid_inclination[k] *= dir;
+    }
+
+    grid_begin = begin;
+    grid_step = step;
+    grid_inv_step = 1.0 / step;
+    is_grid_interpolated = interpolate;
+
+    Journal::instance()->info(QString("Profile grid table: %1 nodes, step %2 m%3")
+                              .arg(nodes)
+                              .arg(step)
+                              .arg(interpolate ? ", interpolated" : ""));
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Profile::average(double begin, double end, size_t &idx,
+                      double &avg_inclination, double &avg_curvature) const
+{
+    size_t last = count - 2;
+
+    // Nodes go in ascending order, so element index only grows
+    while ( (idx < last) && (coord[idx + 1] <= begin) )
+        idx++;
+
+    if (end <= begin)
+    {
+        avg_inclination = inclination[idx];
+        avg_curvature = curvature[idx];
+        return;
+    }
+
+    double sum_inclination = 0.0;
+    double sum_curvature = 0.0;
+    double x = begin;
+
+    for (size_t i = idx; (i <= last) && (x < end); ++i)
+    {
+        double segment_end = std::min(coord[i + 1], end);
+        double length = segment_end - x;
+
+        sum_inclination += length * inclination[i];
+        sum_curvature += length * curvature[i];
+
+        x = segment_end;
+    }
+
+    avg_inclination = sum_inclination / (end - begin);
+    avg_curvature = sum_curvature / (end - begin);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+profile_element_t Profile::gridElement(double railway_coord) const
+{
     profile_element_t profile_element;
 
+    double u = (railway_coord - grid_begin) * grid_inv_step;
+
+    if (is_grid_interpolated)
+    {
+        // Coordinate is before profile end, so next node exists
+        size_t k = std::min(static_cast<size_t>(u), grid_inclination.size() - 2);
+        double frac = u - static_cast<double>(k);
+
+        profile_element.railway_coord = grid_begin + static_cast<double>(k) * grid_step;
+        profile_element.inclination = grid_inclination[k] + (grid_inclination[k + 1] - grid_inclination[k]) * frac;
+        profile_element.curvature = grid_curvature[k] + (grid_curvature[k + 1] - grid_curvature[k]) * frac;
+    }
+    else
+    {
+        size_t k = std::min(static_cast<size_t>(u + 0.5), grid_inclination.size() - 1);
+
+        profile_element.railway_coord = grid_begin + static_cast<double>(k) * grid_step;
+        profile_element.inclination = grid_inclination[k];
+        profile_element.curvature = grid_curvature[k];
+    }
+
+    return profile_element;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+size_t Profile::findIndex(double railway_coord) const
+{
     size_t left_idx = 0;
-    size_t right_idx = profile_data.size() - 1;
+    size_t right_idx = count - 1;
     size_t idx = (left_idx + right_idx) / 2;
 
     while (idx != left_idx)
     {
-        profile_element = profile_data.at(idx);
-
-        if (railway_coord <= profile_element.railway_coord)
+        if (railway_coord <= coord[idx])
             right_idx = idx;
         else
             left_idx = idx;
@@ -80,8 +251,27 @@ profile_element_t Profile::getElement(double railway_coord)
         idx = (left_idx + right_idx) / 2;
     }
 
-    profile_element = profile_data.at(idx);
-    profile_element.inclination *= dir;
+    return idx;
+}
+
+//------------------------------------------------------------------------------
+//  Element idx covers (coord[idx], coord[idx + 1]], first one - its begin too
+//------------------------------------------------------------------------------
+bool Profile::isInElement(size_t idx, double railway_coord) const
+{
+    return ( (idx == 0) || (coord[idx] < railway_coord) ) &&
+           (railway_coord <= coord[idx + 1]);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+profile_element_t Profile::elementAt(size_t idx) const
+{
+    profile_element_t profile_element;
+    profile_element.railway_coord = coord[idx];
+    profile_element.inclination = inclination[idx] * dir;
+    profile_element.curvature = curvature[idx];
 
     return profile_element;
 }
@@ -97,6 +287,11 @@ bool Profile::load(const std::string &path)
         return false;
     }
 
+    std::string binary_path = binaryPath(path);
+
+    if (loadBinary(binary_path, path))
+        return true;
+
     std::ifstream stream(path.c_str(), std::ios::in);
 
     if (!stream.is_open())
@@ -106,7 +301,18 @@ bool Profile::load(const std::string &path)
         return false;
     }
 
-    return load(stream);
+    if (!load(stream))
+        return false;
+
+    setTextData();
+
+    // Next start will map binary profile
+    if (saveBinary(binary_path, path))
+        Journal::instance()->info("Binary profile is written to " + QString(binary_path.c_str()));
+    else
+        Journal::instance()->warning("Can't write binary profile " + QString(binary_path.c_str()));
+
+    return true;
 }
 
 //------------------------------------------------------------------------------
@@ -143,8 +349,170 @@ bool Profile::load(std::ifstream &stream)
 
         profile_element.railway_coord *= 1000.0;
 
-        profile_data.push_back(profile_element);
+        coord_data.push_back(profile_element.railway_coord);
+        inclination_data.push_back(profile_element.inclination);
+        curvature_data.push_back(profile_element.curvature);
     }
 
     return true;
 }
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Profile::setTextData()
+{
+    count = coord_data.size();
+    coord = coord_data.data();
+    inclination = inclination_data.data();
+    curvature = curvature_data.data();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+std::string Profile::binaryPath(const std::string &text_path)
+{
+    size_t dot = text_path.find_last_of('.');
+    size_t sep = text_path.find_last_of("/\\");
+
+    if ( (dot == std::string::npos) || ( (sep != std::string::npos) && (dot < sep) ) )
+        return text_path + PROFILE_BINARY_EXT;
+
+    return text_path.substr(0, dot) + PROFILE_BINARY_EXT;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool Profile::convert(const std::string &text_path, const std::string &binary_path)
+{
+    std::ifstream stream(text_path.c_str(), std::ios::in);
+
+    if (!stream.is_open())
+    {
+        Journal::instance()->error("File " + QString(text_path.c_str()) + " is't found");
+        return false;
+    }
+
+    Profile profile;
+
+    if (!profile.load(stream))
+        return false;
+
+    profile.setTextData();
+
+    return profile.saveBinary(binary_path, text_path);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool Profile::loadBinary(const std::string &binary_path, const std::string &text_path)
+{
+    QFile *file = new QFile(QString(binary_path.c_str()));
+
+    if (!file->exists() || !file->open(QIODevice::ReadOnly))
+    {
+        delete file;
+        return false;
+    }
+
+    qint64 size = file->size();
+    uchar *data = nullptr;
+
+    if (size >= static_cast<qint64>(sizeof(profile_binary_header_t)))
+        data = file->map(0, size);
+
+    if (data == nullptr)
+    {
+        delete file;
+        return false;
+    }
+
+    profile_binary_header_t header;
+    memcpy(&header, data, sizeof(header));
+
+    quint64 array_size = header.count * sizeof(double);
+    quint64 file_size = static_cast<quint64>(size);
+
+    auto is_array_valid = [array_size, file_size](quint64 offset)
+    {
+        return (offset % sizeof(double) == 0) &&
+               (offset >= sizeof(profile_binary_header_t)) &&
+               (offset <= file_size) &&
+               (array_size <= file_size - offset);
+    };
+
+    bool is_valid = (header.magic == PROFILE_BINARY_MAGIC) &&
+                    (header.version == PROFILE_BINARY_VERSION) &&
+                    (header.count <= file_size / sizeof(double)) &&
+                    is_array_valid(header.coord_offset) &&
+                    is_array_valid(header.inclination_offset) &&
+                    is_array_valid(header.curvature_offset);
+
+    // Text profile is changed since binary one was written
+    QFileInfo text_info(QString(text_path.c_str()));
+
+    bool is_actual = !text_info.exists() ||
+                     ( (header.source_size == text_info.size()) &&
+                       (header.source_mtime == text_info.lastModified().toMSecsSinceEpoch()) );
+
+    if (!is_valid || !is_actual)
+    {
+        Journal::instance()->info("Binary profile " + QString(binary_path.c_str()) + " is out of date");
+        delete file;
+        return false;
+    }
+
+    count = static_cast<size_t>(header.count);
+    coord = reinterpret_cast<const double *>(data + header.coord_offset);
+    inclination = reinterpret_cast<const double *>(data + header.inclination_offset);
+    curvature = reinterpret_cast<const double *>(data + header.curvature_offset);
+
+    binary_file = file;
+
+    Journal::instance()->info(QString("Mapped binary profile %1, %2 elements")
+                              .arg(binary_path.c_str())
+                              .arg(count));
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool Profile::saveBinary(const std::string &binary_path, const std::string &text_path) const
+{
+    profile_binary_header_t header;
+    QFileInfo text_info(QString(text_path.c_str()));
+
+    if (text_info.exists())
+    {
+        header.source_size = text_info.size();
+        header.source_mtime = text_info.lastModified().toMSecsSinceEpoch();
+    }
+
+    quint64 array_size = static_cast<quint64>(count) * sizeof(double);
+
+    header.count = static_cast<quint64>(count);
+    header.coord_offset = sizeof(profile_binary_header_t);
+    header.inclination_offset = header.coord_offset + array_size;
+    header.curvature_offset = header.inclination_offset + array_size;
+
+    // File is replaced only when completely written, so concurrently
+    // started simulator never maps partial file
+    QSaveFile file(QString(binary_path.c_str()));
+
+    if (!file.open(QIODevice::WriteOnly))
+        return false;
+
+    qint64 size = static_cast<qint64>(array_size);
+
+    file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char *>(coord), size);
+    file.write(reinterpret_cast<const char *>(inclination), size);
+    file.write(reinterpret_cast<const char *>(curvature), size);
+
+    return file.commit();
+}
@@ -0,0 +1,22 @@
+TEMPLATE = app
+
+QT -= gui
+
+CONFIG += c++11
+CONFIG += console
+CONFIG -= app_bundle
+
+DESTDIR += ../../../bin
+
+TARGET = rkf5-benchmark
+
+CONFIG(debug, debug|release) {
+
+    TARGET = $$join(TARGET,,,_d)
+}
+
+INCLUDEPATH += ../rkf5-simd/include
+
+# Kernels are built in directly: solver plugin exports only GET_SOLVER
+SOURCES += ../rkf5-simd/src/rkf5-kernels.cpp
+SOURCES += $$files(./src/*.cpp)
@@ -0,0 +1,167 @@
+//------------------------------------------------------------------------------
+//
+//      Benchmark of RKF5 stage kernels
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Benchmark of RKF5 stage kernels
+ * \copyright maisvendoo
+ *
+ * Stage kernels of rkf5-simd solver are called in the same sequence, as in
+ * one RKF5SimdSolver step: five intermediate stages and the final one.
+ * Derivatives are fixed pseudo-random arrays, so only kernels are timed.
+ * Every kernel set, supported by CPU, is compared with scalar kernels
+ * bit for bit
+ */
+
+#include    <chrono>
+#include    <cstdio>
+#include    <vector>
+
+#include    "rkf5-kernels.h"
+
+//------------------------------------------------------------------------------
+//  RKF5 tableau, as in RKF5SimdSolver
+//------------------------------------------------------------------------------
+static const double b2[1] = { 0.25 };
+static const double b3[2] = { 3.0 / 32, 9.0 / 32 };
+static const double b4[3] = { 1932.0 / 2197, -7200.0 / 2197, 7296.0 / 2197 };
+static const double b5[4] = { 439.0 / 216, -8.0, 3680.0 / 513, -845.0 / 4140 };
+static const double b6[5] = { -8.0 / 27, 2.0, -3544.0 / 2565, 1859.0 / 4104, -11.0 / 40 };
+
+static const double c[6] = { 16.0 / 135, 0.0, 6656.0 / 12825, 28561.0 / 56430, -9.0 / 50, 2.0 / 55 };
+static const double e[6] = { 1.0 / 360, 0.0, -128.0 / 4275, -2197.0 / 75240, 1.0 / 50, 2.0 / 55 };
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct step_data_t
+{
+    std::vector<double> Y;
+    std::vector<double> dYdt[6];
+    std::vector<double> k[6];
+    std::vector<double> Y1;
+    double              delta;
+
+    step_data_t(size_t n)
+        : Y(n)
+        , Y1(n)
+        , delta(0.0)
+    {
+        unsigned int seed = 12345;
+
+        auto random = [&seed]()
+        {
+            seed = seed * 1103515245 + 12345;
+            return static_cast<double>((seed >> 8) % 20001) / 1e4 - 1.0;
+        };
+
+        for (size_t i = 0; i < n; i++)
+            Y[i] = 100.0 * random();
+
+        for (size_t s = 0; s < 6; s++)
+        {
+            dYdt[s].resize(n);
+            k[s].resize(n);
+
+            for (size_t i = 0; i < n; i++)
+                dYdt[s][i] = 10.0 * random();
+        }
+    }
+};
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static void step(const rkf5_kernels_t &kernels, step_data_t &data, double dt)
+{
+    size_t n = data.Y.size();
+
+    double *kv[6];
+
+    for (size_t s = 0; s < 6; s++)
+        kv[s] = data.k[s].data();
+
+    const double * const *kc = kv;
+
+    const double *Y = data.Y.data();
+    double *Y1 = data.Y1.data();
+
+    kernels.stage(n, dt, data.dYdt[0].data(), kv[0], Y, Y1, b2, kc, 1);
+    kernels.stage(n, dt, data.dYdt[1].data(), kv[1], Y, Y1, b3, kc, 2);
+    kernels.stage(n, dt, data.dYdt[2].data(), kv[2], Y, Y1, b4, kc, 3);
+    kernels.stage(n, dt, data.dYdt[3].data(), kv[3], Y, Y1, b5, kc, 4);
+    kernels.stage(n, dt, data.dYdt[4].data(), kv[4], Y, Y1, b6, kc, 5);
+
+    data.delta = kernels.final_stage(n, dt, data.dYdt[5].data(), Y, Y1, c, e, kv);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static bool isEqual(const step_data_t &a, const step_data_t &b)
+{
+    if (a.delta != b.delta)
+        return false;
+
+    if (a.Y1 != b.Y1)
+        return false;
+
+    for (size_t s = 0; s < 6; s++)
+    {
+        if (a.k[s] != b.k[s])
+            return false;
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int main()
+{
+    const double dt = 1e-3;
+    const int reps = 2000;
+
+    std::vector<rkf5_kernels_t> kernels = rkf5_supported_kernels();
+    bool is_equal = true;
+
+    fputs("    n  kernels   us/step  speedup  equal\n", stdout);
+
+    for (size_t n : {1000, 2000, 5000, 10000})
+    {
+        step_data_t reference(n);
+        step(kernels.front(), reference, dt);
+
+        double scalar_time = 0;
+
+        for (auto &k : kernels)
+        {
+            step_data_t data(n);
+
+            auto t0 = std::chrono::steady_clock::now();
+
+            for (int rep = 0; rep < reps; rep++)
+                step(k, data, dt);
+
+            auto t1 = std::chrono::steady_clock::now();
+
+            double step_time = std::chrono::duration<double, std::micro>(t1 - t0).count() / reps;
+
+            if (scalar_time == 0)
+                scalar_time = step_time;
+
+            bool is_step_equal = isEqual(reference, data);
+            is_equal = is_equal && is_step_equal;
+
+            fprintf(stdout, "%5zu  %-8s %8.2f %8.2f  %s\n",
+                    n, k.name, step_time, scalar_time / step_time,
+                    is_step_equal ? "yes" : "NO");
+        }
+    }
+
+    return is_equal ? 0 : 1;
+}
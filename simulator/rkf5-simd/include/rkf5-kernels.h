@@ -0,0 +1,88 @@
+//------------------------------------------------------------------------------
+//
+//      Vectorized stage kernels for RKF5 method
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Vectorized stage kernels for RKF5 method
+ * \copyright maisvendoo
+ */
+
+#ifndef     RKF5_KERNELS_H
+#define     RKF5_KERNELS_H
+
+#include    <cstddef>
+#include    <vector>
+
+/*!
+ * \typedef
+ * \brief Intermediate stage kernel
+ *
+ * k_new[i] = dt * dYdt[i]
+ * Y1[i] = Y[i] + b[0] * k[0][i] + ... + b[m - 1] * k[m - 1][i]
+ *
+ * where k[m - 1] is k_new
+ */
+typedef void (*rkf5_stage_t)(size_t n,
+                             double dt,
+                             const double *dYdt,
+                             double *k_new,
+                             const double *Y,
+                             double *Y1,
+                             const double *b,
+                             const double * const *k,
+                             size_t m);
+
+/*!
+ * \typedef
+ * \brief Final stage kernel
+ *
+ * k[5][i] = dt * dYdt[i]
+ * Y1[i] = Y[i] + c[0] * k[0][i] + ... + c[5] * k[5][i]
+ *
+ * Returns max(|e[0] * k[0][i] + ... + e[5] * k[5][i]|)
+ */
+typedef double (*rkf5_final_t)(size_t n,
+                               double dt,
+                               const double *dYdt,
+                               const double *Y,
+                               double *Y1,
+                               const double *c,
+                               const double *e,
+                               double * const *k);
+
+/*!
+ * \struct
+ * \brief Set of kernels for one instruction set
+ */
+struct rkf5_kernels_t
+{
+    /// Instruction set name
+    const char      *name;
+    /// Intermediate stage kernel
+    rkf5_stage_t    stage;
+    /// Final stage kernel
+    rkf5_final_t    final_stage;
+};
+
+/*!
+ * \fn
+ * \brief Select best kernels supported by CPU
+ */
+rkf5_kernels_t rkf5_select_kernels();
+
+/*!
+ * \fn
+ * \brief Scalar kernels (fallback for any CPU)
+ */
+rkf5_kernels_t rkf5_scalar_kernels();
+
+/*!
+ * \fn
+ * \brief All kernels supported by CPU, scalar ones first
+ */
+std::vector<rkf5_kernels_t> rkf5_supported_kernels();
+
+#endif // RKF5_KERNELS_H
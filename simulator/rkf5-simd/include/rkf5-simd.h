@@ -0,0 +1,59 @@
+#ifndef     RKF5_SIMD_H
+#define     RKF5_SIMD_H
+
+#include    "solver.h"
+#include    "rkf5-kernels.h"
+
+/*!
+ *  \class
+ *  \brief 5-6 order Runge-Kutta's integration method with vectorized stages
+ *
+ *  Same method as RKF5Solver. Stage updates and local error estimation are
+ *  performed by fused SIMD kernels, selected at runtime by CPU features
+ */
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+class  RKF5SimdSolver : public Solver
+{
+public:
+
+    RKF5SimdSolver();
+    ~RKF5SimdSolver();
+
+    /// Method step
+    bool step(OdeSystem *ode_sys,
+              state_vector_t &Y,
+              state_vector_t &dYdt,
+              double t,
+              double &dt,
+              double max_step,
+              double local_err);
+
+protected:
+
+    // Butcher tableau rows (zero coefficients are kept for uniform kernels)
+    const double b2[1] = { 0.25 };
+    const double b3[2] = { 3.0 / 32, 9.0 / 32 };
+    const double b4[3] = { 1932.0 / 2197, -7200.0 / 2197, 7296.0 / 2197 };
+    const double b5[4] = { 439.0 / 216, -8.0, 3680.0 / 513, -845.0 / 4140 };
+    const double b6[5] = { -8.0 / 27, 2.0, -3544.0 / 2565, 1859.0 / 4104, -11.0 / 40 };
+
+    const double c[6] = { 16.0 / 135, 0.0, 6656.0 / 12825, 28561.0 / 56430, -9.0 / 50, 2.0 / 55 };
+    const double e[6] = { 1.0 / 360, 0.0, -128.0 / 4275, -2197.0 / 75240, 1.0 / 50, 2.0 / 55 };
+
+    /// Stages values
+    state_vector_t k[6];
+    state_vector_t Y1;
+
+    /// Selected kernels
+    rkf5_kernels_t kernels;
+
+    // First step flag
+    bool first_step;
+
+    // Maximal iteraion count
+    int MAX_ITER;
+};
+
+#endif // RKF5_SIMD_H
@@ -0,0 +1,370 @@
+//------------------------------------------------------------------------------
+//
+//      Vectorized stage kernels for RKF5 method
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Vectorized stage kernels for RKF5 method
+ * \copyright maisvendoo
+ */
+
+#include    "rkf5-kernels.h"
+
+#include    <cmath>
+#include    <algorithm>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define RKF5_X86
+    #include    <immintrin.h>
+
+    #if defined(_MSC_VER)
+        #include    <intrin.h>
+        #define RKF5_TARGET(isa)
+    #else
+        #define RKF5_TARGET(isa)    __attribute__((target(isa)))
+    #endif
+#endif
+
+//------------------------------------------------------------------------------
+//      Scalar kernels
+//------------------------------------------------------------------------------
+static void stage_scalar(size_t n,
+                         double dt,
+                         const double *dYdt,
+                         double *k_new,
+                         const double *Y,
+                         double *Y1,
+                         const double *b,
+                         const double * const *k,
+                         size_t m)
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        k_new[i] = dt * dYdt[i];
+
+        double y = Y[i];
+
+        for (size_t j = 0; j < m; ++j)
+            y += b[j] * k[j][i];
+
+        Y1[i] = y;
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static double final_scalar(size_t n,
+                           double dt,
+                           const double *dYdt,
+                           const double *Y,
+                           double *Y1,
+                           const double *c,
+                           const double *e,
+                           double * const *k)
+{
+    double delta = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        k[5][i] = dt * dYdt[i];
+
+        double err = e[0] * k[0][i];
+        double y = Y[i] + c[0] * k[0][i];
+
+        for (size_t j = 1; j < 6; ++j)
+        {
+            err += e[j] * k[j][i];
+            y += c[j] * k[j][i];
+        }
+
+        Y1[i] = y;
+        delta = std::max(delta, std::abs(err));
+    }
+
+    return delta;
+}
+
+#if defined(RKF5_X86)
+
+//------------------------------------------------------------------------------
+//      SSE2 kernels
+//------------------------------------------------------------------------------
+RKF5_TARGET("sse2")
+static void stage_sse2(size_t n,
+                       double dt,
+                       const double *dYdt,
+                       double *k_new,
+                       const double *Y,
+                       double *Y1,
+                       const double *b,
+                       const double * const *k,
+                       size_t m)
+{
+    __m128d vdt = _mm_set1_pd(dt);
+
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2)
+    {
+        _mm_storeu_pd(k_new + i, _mm_mul_pd(vdt, _mm_loadu_pd(dYdt + i)));
+
+        __m128d y = _mm_loadu_pd(Y + i);
+
+        for (size_t j = 0; j < m; ++j)
+            y = _mm_add_pd(y, _mm_mul_pd(_mm_set1_pd(b[j]), _mm_loadu_pd(k[j] + i)));
+
+        _mm_storeu_pd(Y1 + i, y);
+    }
+
+    const double *kt[6];
+
+    for (size_t j = 0; j < m; ++j)
+        kt[j] = k[j] + i;
+
+    stage_scalar(n - i, dt, dYdt + i, k_new + i, Y + i, Y1 + i, b, kt, m);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+RKF5_TARGET("sse2")
+static double final_sse2(size_t n,
+                         double dt,
+                         const double *dYdt,
+                         const double *Y,
+                         double *Y1,
+                         const double *c,
+                         const double *e,
+                         double * const *k)
+{
+    __m128d vdt = _mm_set1_pd(dt);
+    __m128d sign_mask = _mm_set1_pd(-0.0);
+    __m128d vdelta = _mm_setzero_pd();
+
+    size_t i = 0;
+
+    for (; i + 2 <= n; i += 2)
+    {
+        _mm_storeu_pd(k[5] + i, _mm_mul_pd(vdt, _mm_loadu_pd(dYdt + i)));
+
+        __m128d k0 = _mm_loadu_pd(k[0] + i);
+        __m128d err = _mm_mul_pd(_mm_set1_pd(e[0]), k0);
+        __m128d y = _mm_add_pd(_mm_loadu_pd(Y + i), _mm_mul_pd(_mm_set1_pd(c[0]), k0));
+
+        for (size_t j = 1; j < 6; ++j)
+        {
+            __m128d kj = _mm_loadu_pd(k[j] + i);
+            err = _mm_add_pd(err, _mm_mul_pd(_mm_set1_pd(e[j]), kj));
+            y = _mm_add_pd(y, _mm_mul_pd(_mm_set1_pd(c[j]), kj));
+        }
+
+        _mm_storeu_pd(Y1 + i, y);
+        vdelta = _mm_max_pd(vdelta, _mm_andnot_pd(sign_mask, err));
+    }
+
+    double lanes[2];
+    _mm_storeu_pd(lanes, vdelta);
+
+    double *kt[6];
+
+    for (size_t j = 0; j < 6; ++j)
+        kt[j] = k[j] + i;
+
+    double delta = final_scalar(n - i, dt, dYdt + i, Y + i, Y1 + i, c, e, kt);
+
+    return std::max(delta, std::max(lanes[0], lanes[1]));
+}
+
+//------------------------------------------------------------------------------
+//      AVX2 kernels
+//------------------------------------------------------------------------------
+RKF5_TARGET("avx2")
+static void stage_avx2(size_t n,
+                       double dt,
+                       const double *dYdt,
+                       double *k_new,
+                       const double *Y,
+                       double *Y1,
+                       const double *b,
+                       const double * const *k,
+                       size_t m)
+{
+    __m256d vdt = _mm256_set1_pd(dt);
+
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm256_storeu_pd(k_new + i, _mm256_mul_pd(vdt, _mm256_loadu_pd(dYdt + i)));
+
+        __m256d y = _mm256_loadu_pd(Y + i);
+
+        for (size_t j = 0; j < m; ++j)
+            y = _mm256_add_pd(y, _mm256_mul_pd(_mm256_set1_pd(b[j]), _mm256_loadu_pd(k[j] + i)));
+
+        _mm256_storeu_pd(Y1 + i, y);
+    }
+
+    const double *kt[6];
+
+    for (size_t j = 0; j < m; ++j)
+        kt[j] = k[j] + i;
+
+    stage_scalar(n - i, dt, dYdt + i, k_new + i, Y + i, Y1 + i, b, kt, m);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+RKF5_TARGET("avx2")
+static double final_avx2(size_t n,
+                         double dt,
+                         const double *dYdt,
+                         const double *Y,
+                         double *Y1,
+                         const double *c,
+                         const double *e,
+                         double * const *k)
+{
+    __m256d vdt = _mm256_set1_pd(dt);
+    __m256d sign_mask = _mm256_set1_pd(-0.0);
+    __m256d vdelta = _mm256_setzero_pd();
+
+    size_t i = 0;
+
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm256_storeu_pd(k[5] + i, _mm256_mul_pd(vdt, _mm256_loadu_pd(dYdt + i)));
+
+        __m256d k0 = _mm256_loadu_pd(k[0] + i);
+        __m256d err = _mm256_mul_pd(_mm256_set1_pd(e[0]), k0);
+        __m256d y = _mm256_add_pd(_mm256_loadu_pd(Y + i), _mm256_mul_pd(_mm256_set1_pd(c[0]), k0));
+
+        for (size_t j = 1; j < 6; ++j)
+        {
+            __m256d kj = _mm256_loadu_pd(k[j] + i);
+            err = _mm256_add_pd(err, _mm256_mul_pd(_mm256_set1_pd(e[j]), kj));
+            y = _mm256_add_pd(y, _mm256_mul_pd(_mm256_set1_pd(c[j]), kj));
+        }
+
+        _mm256_storeu_pd(Y1 + i, y);
+        vdelta = _mm256_max_pd(vdelta, _mm256_andnot_pd(sign_mask, err));
+    }
+
+    double lanes[4];
+    _mm256_storeu_pd(lanes, vdelta);
+
+    double *kt[6];
+
+    for (size_t j = 0; j < 6; ++j)
+        kt[j] = k[j] + i;
+
+    double delta = final_scalar(n - i, dt, dYdt + i, Y + i, Y1 + i, c, e, kt);
+
+    delta = std::max(delta, std::max(lanes[0], lanes[1]));
+    delta = std::max(delta, std::max(lanes[2], lanes[3]));
+
+    return delta;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+static bool cpu_has_avx2()
+{
+#if defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+
+    if (info[0] < 7)
+        return false;
+
+    // OSXSAVE and AVX flags, YMM state enabled by OS
+    __cpuid(info, 1);
+
+    if ( (info[2] & (1 << 27)) == 0 || (info[2] & (1 << 28)) == 0 )
+        return false;
+
+    if ( (_xgetbv(0) & 0x6) != 0x6 )
+        return false;
+
+    __cpuidex(info, 7, 0);
+
+    return (info[1] & (1 << 5)) != 0;
+#else
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // RKF5_X86
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+rkf5_kernels_t rkf5_scalar_kernels()
+{
+    rkf5_kernels_t kernels;
+    kernels.name = "scalar";
+    kernels.stage = stage_scalar;
+    kernels.final_stage = final_scalar;
+
+    return kernels;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+rkf5_kernels_t rkf5_select_kernels()
+{
+    rkf5_kernels_t kernels = rkf5_scalar_kernels();
+
+#if defined(RKF5_X86)
+    if (cpu_has_avx2())
+    {
+        kernels.name = "avx2";
+        kernels.stage = stage_avx2;
+        kernels.final_stage = final_avx2;
+    }
+    else
+    {
+        // SSE2 is a baseline of any x86-64 CPU
+        kernels.name = "sse2";
+        kernels.stage = stage_sse2;
+        kernels.final_stage = final_sse2;
+    }
+#endif
+
+    return kernels;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+std::vector<rkf5_kernels_t> rkf5_supported_kernels()
+{
+    std::vector<rkf5_kernels_t> supported;
+    supported.push_back(rkf5_scalar_kernels());
+
+#if defined(RKF5_X86)
+    rkf5_kernels_t kernels;
+
+    kernels.name = "sse2";
+    kernels.stage = stage_sse2;
+    kernels.final_stage = final_sse2;
+    supported.push_back(kernels);
+
+    if (cpu_has_avx2())
+    {
+        kernels.name = "avx2";
+        kernels.stage = stage_avx2;
+        kernels.final_stage = final_avx2;
+        supported.push_back(kernels);
+    }
+#endif
+
+    return supported;
+}
@@ -0,0 +1,121 @@
+#include    "rkf5-simd.h"
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+RKF5SimdSolver::RKF5SimdSolver()
+{
+    MAX_ITER = 100;
+    first_step = true;
+    kernels = rkf5_select_kernels();
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+RKF5SimdSolver::~RKF5SimdSolver()
+{
+
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+bool RKF5SimdSolver::step(OdeSystem *ode_sys,
+                          state_vector_t &Y,
+                          state_vector_t &dYdt,
+                          double t,
+                          double &dt,
+                          double max_step,
+                          double local_err)
+{
+    size_t n = Y.size();
+
+    // Share required memory
+    if (first_step)
+    {
+        for (size_t i = 0; i < 6; ++i)
+            k[i].resize(n);
+
+        Y1.resize(n);
+
+        first_step = false;
+    }
+
+    const double *kc[6] = { k[0].data(), k[1].data(), k[2].data(),
+                            k[3].data(), k[4].data(), k[5].data() };
+
+    double *kv[6] = { k[0].data(), k[1].data(), k[2].data(),
+                      k[3].data(), k[4].data(), k[5].data() };
+
+    // Reset solver
+    bool ready = false;
+    int iter = 0;
+
+    do
+    {
+        // Iteration count increment
+        iter++;
+
+        // Method step
+        ode_sys->calcDerivative(Y, dYdt, t);
+        kernels.stage(n, dt, dYdt.data(), kv[0], Y.data(), Y1.data(), b2, kc, 1);
+
+        ode_sys->calcDerivative(Y1, dYdt, t + dt / 4.0);
+        kernels.stage(n, dt, dYdt.data(), kv[1], Y.data(), Y1.data(), b3, kc, 2);
+
+        ode_sys->calcDerivative(Y1, dYdt, t + 3.0 * dt / 8.0);
+        kernels.stage(n, dt, dYdt.data(), kv[2], Y.data(), Y1.data(), b4, kc, 3);
+
+        ode_sys->calcDerivative(Y1, dYdt, t + 12.0 * dt / 13.0);
+        kernels.stage(n, dt, dYdt.data(), kv[3], Y.data(), Y1.data(), b5, kc, 4);
+
+        ode_sys->calcDerivative(Y1, dYdt, t + dt);
+        kernels.stage(n, dt, dYdt.data(), kv[4], Y.data(), Y1.data(), b6, kc, 5);
+
+        ode_sys->calcDerivative(Y1, dYdt, t + dt / 2.0);
+
+        // New state vector's value and local error
+        double delta = kernels.final_stage(n, dt, dYdt.data(), Y.data(), Y1.data(), c, e, kv);
+
+        // Check error
+        if (delta >= local_err)
+        {
+            dt = dt / 2;
+            ready = false;
+        }
+
+        if (delta <= local_err / 32.0)
+        {
+            dt = 2 * dt;
+
+            if (dt > max_step)
+                dt = max_step;
+
+            ready = true;
+        }
+
+        if ((delta > local_err / 32.0) && (delta < local_err))
+        {
+            ready = true;
+        }
+
+        // Store new value
+        if (ready)
+        {
+            Y.swap(Y1);
+        }
+
+    } while ((!ready) && (iter <= MAX_ITER));
+
+    // Check interation count
+    if (iter > MAX_ITER)
+        return false;
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+GET_SOLVER(RKF5SimdSolver)
@@ -0,0 +1,97 @@
+//------------------------------------------------------------------------------
+//
+//      Band matrix with LU-factorization
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Band matrix with LU-factorization
+ * \copyright maisvendoo
+ */
+
+#ifndef     BAND_MATRIX_H
+#define     BAND_MATRIX_H
+
+#include    <vector>
+#include    <cstddef>
+
+/*!
+ * \class
+ * \brief Square band matrix, stored by columns (LAPACK band layout)
+ *
+ * Extra kl superdiagonals are reserved for fill-in, which appears while
+ * LU-factorization with partial pivoting is performed
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class BandMatrix
+{
+public:
+
+    /// Constructor
+    BandMatrix();
+    /// Destructor
+    ~BandMatrix();
+
+    /// Set matrix order and bandwidth
+    void resize(size_t n, size_t kl, size_t ku);
+
+    /// Set all elements to zero
+    void clear();
+
+    /// Element access (i, j must be inside band)
+    double &at(size_t i, size_t j)
+    {
+        return elem(i, j);
+    }
+
+    /// Check element is inside band
+    bool isInBand(size_t i, size_t j) const
+    {
+        return (i + ku >= j) && (j + kl >= i);
+    }
+
+    /// LU-factorization with partial pivoting
+    bool factorize();
+
+    /// Solve system A * x = b using LU-factors, b is replaced by x
+    void solve(double *b) const;
+
+    size_t getOrder() const { return n; }
+
+    size_t getLower() const { return kl; }
+
+    size_t getUpper() const { return ku; }
+
+private:
+
+    /// Matrix order
+    size_t  n;
+    /// Number of subdiagonals
+    size_t  kl;
+    /// Number of superdiagonals
+    size_t  ku;
+    /// Main diagonal row in storage
+    size_t  kv;
+    /// Storage column length
+    size_t  ldab;
+
+    /// Band storage
+    std::vector<double> ab;
+    /// Pivot indices
+    std::vector<size_t> ipiv;
+
+    double &elem(size_t i, size_t j)
+    {
+        return ab[(kv + i - j) + j * ldab];
+    }
+
+    double elem(size_t i, size_t j) const
+    {
+        return ab[(kv + i - j) + j * ldab];
+    }
+};
+
+#endif // BAND_MATRIX_H
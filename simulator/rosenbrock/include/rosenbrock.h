@@ -0,0 +1,125 @@
+#ifndef     ROSENBROCK_H
+#define     ROSENBROCK_H
+
+#include    "solver.h"
+#include    "band-matrix.h"
+
+/*!
+ *  \class
+ *  \brief Linearly implicit Rosenbrock W-method 3(2) for stiff ODE's
+ *
+ *  Four-stage W-method of 3rd order with embedded 2nd order solution
+ *  for error estimation (ROS34PW2 tableau, Rang & Angermann). It is
+ *  L-stable and stiffly accurate. Suitable for stiff couplings and
+ *  friction forces.
+ *
+ *  Jacobian is calculated numerically in band form, using bandwidth
+ *  reported by ODE system. Columns, which are separated more than
+ *  bandwidth, are perturbed together, so Jacobian costs kl + ku + 1
+ *  right part evaluations. W-method keeps its order with approximate
+ *  Jacobian, so Jacobian is reused across steps and updated
+ *  periodically or after step rejection
+ */
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+class  RosenbrockSolver : public Solver
+{
+public:
+
+    RosenbrockSolver();
+    ~RosenbrockSolver();
+
+    /// Method step
+    bool step(OdeSystem *ode_sys,
+              state_vector_t &Y,
+              state_vector_t &dYdt,
+              double t,
+              double &dt,
+              double max_step,
+              double local_err);
+
+protected:
+
+    // Stages number
+    static const size_t S = 4;
+
+    // ROS34PW2 tableau in transformed form (Hairer, Wanner)
+    const double a21 = 2.0;
+    const double a31 = 1.4192173174557647;
+    const double a32 = -0.2592322116729697;
+    const double a41 = 4.1847604823191600;
+    const double a42 = -0.28519201735549593;
+    const double a43 = 2.2942803602790414;
+
+    const double c21 = -4.5885607205580840;
+    const double c31 = -4.1847604823191600;
+    const double c32 = 0.28519201735549593;
+    const double c41 = -6.3681792001283580;
+    const double c42 = -6.7956209444668370;
+    const double c43 = 2.8700986043310560;
+
+    const double m[S] = { 4.1847604823191600,
+                          -0.28519201735549593,
+                          2.2942803602790414,
+                          1.0 };
+
+    const double e[S] = { 0.27774994764796790,
+                          -1.4032398951759992,
+                          1.7726301276675507,
+                          0.5 };
+
+    const double alpha2 = 0.87173304301691801;
+    const double alpha3 = 0.73157995778885237;
+    const double alpha4 = 1.0;
+
+    const double gamma = 0.43586652150845900;
+
+    // Order of error estimation
+    const double ELO = 3.0;
+
+    // Step size control parameters
+    const double safety = 0.9;
+    const double fac_min = 0.2;
+    const double fac_max = 6.0;
+
+    // Steps count between Jacobian updates
+    const int JACOBIAN_UPDATE_STEPS = 10;
+
+    /// Jacobian matrix
+    BandMatrix  J;
+    /// Method matrix I / (gamma * h) - J
+    BandMatrix  M;
+
+    state_vector_t f0;
+    state_vector_t f1;
+    state_vector_t k1;
+    state_vector_t k2;
+    state_vector_t k3;
+    state_vector_t k4;
+    state_vector_t Y1;
+
+    // First step flag
+    bool first_step;
+
+    // Jacobian is valid
+    bool is_jacobian_valid;
+
+    // Steps count since last Jacobian update
+    int jacobian_age;
+
+    // Proposed next step and step returned to caller
+    double dt_next;
+    double dt_returned;
+
+    // Maximal iteraion count
+    int MAX_ITER;
+
+    /// Numerical Jacobian calculation
+    void calcJacobian(OdeSystem *ode_sys, state_vector_t &Y, double t);
+
+    /// Fill method matrix and factorize it
+    bool prepareMatrix(double h);
+};
+
+#endif // ROSENBROCK_H
@@ -0,0 +1,157 @@
+//------------------------------------------------------------------------------
+//
+//      Band matrix with LU-factorization
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Band matrix with LU-factorization
+ * \copyright maisvendoo
+ */
+
+#include    "band-matrix.h"
+
+#include    <cmath>
+#include    <algorithm>
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+BandMatrix::BandMatrix()
+    : n(0)
+    , kl(0)
+    , ku(0)
+    , kv(0)
+    , ldab(1)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+BandMatrix::~BandMatrix()
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void BandMatrix::resize(size_t n, size_t kl, size_t ku)
+{
+    this->n = n;
+    this->kl = kl;
+    this->ku = ku;
+
+    kv = kl + ku;
+    ldab = 2 * kl + ku + 1;
+
+    ab.resize(ldab * n);
+    ipiv.resize(n);
+
+    clear();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void BandMatrix::clear()
+{
+    std::fill(ab.begin(), ab.end(), 0.0);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool BandMatrix::factorize()
+{
+    // Last column affected by row interchanges
+    size_t ju = 0;
+
+    for (size_t j = 0; j < n; ++j)
+    {
+        size_t km = std::min(kl, n - 1 - j);
+
+        // Pivot search in column j
+        size_t jp = 0;
+        double amax = std::abs(elem(j, j));
+
+        for (size_t p = 1; p <= km; ++p)
+        {
+            double v = std::abs(elem(j + p, j));
+
+            if (v > amax)
+            {
+                amax = v;
+                jp = p;
+            }
+        }
+
+        ipiv[j] = j + jp;
+
+        if (amax == 0.0)
+            return false;
+
+        ju = std::max(ju, std::min(j + ku + jp, n - 1));
+
+        // Rows interchange
+        if (jp != 0)
+        {
+            for (size_t c = j; c <= ju; ++c)
+                std::swap(elem(j, c), elem(j + jp, c));
+        }
+
+        // Elimination
+        double pivot = elem(j, j);
+
+        for (size_t r = 1; r <= km; ++r)
+            elem(j + r, j) /= pivot;
+
+        for (size_t c = j + 1; c <= ju; ++c)
+        {
+            double u = elem(j, c);
+
+            if (u == 0.0)
+                continue;
+
+            for (size_t r = 1; r <= km; ++r)
+                elem(j + r, c) -= elem(j + r, j) * u;
+        }
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void BandMatrix::solve(double *b) const
+{
+    // Forward substitution with L
+    for (size_t j = 0; j + 1 < n; ++j)
+    {
+        size_t km = std::min(kl, n - 1 - j);
+        size_t l = ipiv[j];
+
+        if (l != j)
+            std::swap(b[l], b[j]);
+
+        for (size_t r = 1; r <= km; ++r)
+            b[j + r] -= elem(j + r, j) * b[j];
+    }
+
+    // Back substitution with U
+    for (size_t jj = n; jj > 0; --jj)
+    {
+        size_t j = jj - 1;
+
+        b[j] /= elem(j, j);
+
+        size_t i0 = (j > kv) ? j - kv : 0;
+
+        for (size_t i = i0; i < j; ++i)
+            b[i] -= elem(i, j) * b[j];
+    }
+}
@@ -0,0 +1,249 @@
+#include    "rosenbrock.h"
+
+#include    <cmath>
+#include    <cfloat>
+#include    <algorithm>
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+RosenbrockSolver::RosenbrockSolver()
+    : first_step(true)
+    , is_jacobian_valid(false)
+    , jacobian_age(0)
+    , dt_next(0.0)
+    , dt_returned(0.0)
+    , MAX_ITER(100)
+{
+
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+RosenbrockSolver::~RosenbrockSolver()
+{
+
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+bool RosenbrockSolver::step(OdeSystem *ode_sys,
+                            state_vector_t &Y,
+                            state_vector_t &dYdt,
+                            double t,
+                            double &dt,
+                            double max_step,
+                            double local_err)
+{
+    size_t n = Y.size();
+
+    if (n == 0)
+        return true;
+
+    // Share required memory
+    if (first_step)
+    {
+        size_t kl = 0;
+        size_t ku = 0;
+
+        if (!ode_sys->getJacobianBandwidth(kl, ku))
+        {
+            kl = ku = n - 1;
+        }
+
+        kl = std::min(kl, n - 1);
+        ku = std::min(ku, n - 1);
+
+        J.resize(n, kl, ku);
+        M.resize(n, kl, ku);
+
+        f0.resize(n);
+        f1.resize(n);
+        k1.resize(n);
+        k2.resize(n);
+        k3.resize(n);
+        k4.resize(n);
+        Y1.resize(n);
+
+        first_step = false;
+    }
+
+    // Caller returns step taken before, so use proposed one.
+    // Otherwise step was changed by caller
+    double h = dt;
+
+    if ( (dt_next > 0) && (dt == dt_returned) )
+        h = dt_next;
+
+    h = std::min(h, max_step);
+
+    ode_sys->calcDerivative(Y, f0, t);
+
+    if (!is_jacobian_valid || (jacobian_age >= JACOBIAN_UPDATE_STEPS))
+        calcJacobian(ode_sys, Y, t);
+
+    int iter = 0;
+
+    do
+    {
+        // Iteration count increment
+        iter++;
+
+        if (!prepareMatrix(h))
+        {
+            h = h / 2;
+            continue;
+        }
+
+        // Stage 1
+        std::copy(f0.begin(), f0.end(), k1.begin());
+        M.solve(k1.data());
+
+        // Stage 2
+        for (size_t i = 0; i < n; ++i)
+            Y1[i] = Y[i] + a21 * k1[i];
+
+        ode_sys->calcDerivative(Y1, f1, t + alpha2 * h);
+
+        for (size_t i = 0; i < n; ++i)
+            k2[i] = f1[i] + c21 / h * k1[i];
+
+        M.solve(k2.data());
+
+        // Stage 3
+        for (size_t i = 0; i < n; ++i)
+            Y1[i] = Y[i] + a31 * k1[i] + a32 * k2[i];
+
+        ode_sys->calcDerivative(Y1, f1, t + alpha3 * h);
+
+        for (size_t i = 0; i < n; ++i)
+            k3[i] = f1[i] + c31 / h * k1[i] + c32 / h * k2[i];
+
+        M.solve(k3.data());
+
+        // Stage 4
+        for (size_t i = 0; i < n; ++i)
+            Y1[i] = Y[i] + a41 * k1[i] + a42 * k2[i] + a43 * k3[i];
+
+        ode_sys->calcDerivative(Y1, f1, t + alpha4 * h);
+
+        for (size_t i = 0; i < n; ++i)
+            k4[i] = f1[i] + c41 / h * k1[i] + c42 / h * k2[i] + c43 / h * k3[i];
+
+        M.solve(k4.data());
+
+        // New state and local error
+        double delta = 0;
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            Y1[i] = Y[i] + m[0] * k1[i] + m[1] * k2[i] + m[2] * k3[i] + m[3] * k4[i];
+
+            double eps = e[0] * k1[i] + e[1] * k2[i] + e[2] * k3[i] + e[3] * k4[i];
+            delta = std::max(delta, std::abs(eps));
+        }
+
+        double err = delta / local_err;
+        double fac = safety * pow(std::max(err, 1e-10), -1.0 / ELO);
+
+        if (err <= 1.0)
+        {
+            std::copy(Y1.begin(), Y1.end(), Y.begin());
+            std::copy(f0.begin(), f0.end(), dYdt.begin());
+
+            jacobian_age++;
+
+            dt = h;
+            dt_returned = dt;
+            dt_next = std::min(h * std::min(fac_max, fac), max_step);
+
+            return true;
+        }
+
+        // Step is rejected. Jacobian may be too old
+        h = h * std::max(fac_min, fac);
+
+        if (jacobian_age > 0)
+            calcJacobian(ode_sys, Y, t);
+
+    } while (iter <= MAX_ITER);
+
+    return false;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+void RosenbrockSolver::calcJacobian(OdeSystem *ode_sys, state_vector_t &Y, double t)
+{
+    size_t n = Y.size();
+    size_t kl = J.getLower();
+    size_t ku = J.getUpper();
+
+    // Columns, which are separated more than bandwidth, don't affect
+    // same rows, so they are perturbed together
+    size_t groups = std::min(n, kl + ku + 1);
+
+    const double eps = sqrt(DBL_EPSILON);
+
+    J.clear();
+    std::copy(Y.begin(), Y.end(), Y1.begin());
+
+    for (size_t g = 0; g < groups; ++g)
+    {
+        for (size_t j = g; j < n; j += groups)
+            Y1[j] = Y[j] + eps * std::max(1.0, std::abs(Y[j]));
+
+        ode_sys->calcDerivative(Y1, f1, t);
+
+        for (size_t j = g; j < n; j += groups)
+        {
+            double delta = Y1[j] - Y[j];
+
+            size_t i0 = (j > ku) ? j - ku : 0;
+            size_t i1 = std::min(n - 1, j + kl);
+
+            for (size_t i = i0; i <= i1; ++i)
+                J.at(i, j) = (f1[i] - f0[i]) / delta;
+
+            Y1[j] = Y[j];
+        }
+    }
+
+    is_jacobian_valid = true;
+    jacobian_age = 0;
+}
+
+//-----------------------------------------------------------------------------
+//
+//-----------------------------------------------------------------------------
+bool RosenbrockSolver::prepareMatrix(double h)
+{
+    size_t n = J.getOrder();
+    size_t kl = J.getLower();
+    size_t ku = J.getUpper();
+
+    M.clear();
+
+    double ghinv = 1.0 / (gamma * h);
+
+    for (size_t j = 0; j < n; ++j)
+    {
+        size_t i0 = (j > ku) ? j - ku : 0;
+        size_t i1 = std::min(n - 1, j + kl);
+
+        for (size_t i = i0; i <= i1; ++i)
+            M.at(i, j) = -J.at(i, j);
+
+        M.at(j, j) += ghinv;
+    }
+
+    return M.factorize();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+GET_SOLVER(RosenbrockSolver)
@@ -7,17 +7,26 @@ SUBDIRS += ./physics
 SUBDIRS += ./device
 SUBDIRS += ./solver
 SUBDIRS += ./rkf5
+SUBDIRS += ./rkf5-simd
+SUBDIRS += ./rkf5-benchmark
+SUBDIRS += ./dopri5
+SUBDIRS += ./rosenbrock
 SUBDIRS += ./rk4
 SUBDIRS += ./vehicle
+SUBDIRS += ./acceleration-benchmark
 SUBDIRS += ./coupling
 SUBDIRS += ./brakepipe
+SUBDIRS += ./brakepipe-benchmark
 SUBDIRS += ./profile
+SUBDIRS += ./profile-converter
+SUBDIRS += ./profile-benchmark
 SUBDIRS += ./train
 SUBDIRS += ./sim-client
 SUBDIRS += ./model
 SUBDIRS += ./default-coupling
 SUBDIRS += ./ef-coupling
 SUBDIRS += ./simulator
+SUBDIRS += ./sweep
 
 SUBDIRS += ./modbus
 
@@ -92,8 +92,14 @@ bool AppCore::init()
 //------------------------------------------------------------------------------
 int AppCore::exec()
 {
-    if (model != Q_NULLPTR)
-        model->start();
+    if (model == Q_NULLPTR)
+        return QCoreApplication::exec();
+
+    // Batch simulation doesn't need events loop
+    if (model->isBatchMode())
+        return model->runBatch() ? 0 : 1;
+
+    model->start();
 
     return QCoreApplication::exec();
 }
@@ -180,6 +186,36 @@ CommandLineParesrResult AppCore::parseCommandLine(QCommandLineParser &parser,
 
     parser.addOption(direction);
 
+    QCommandLineOption initVelocity(QStringList() << "init-velocity",
+                                    QCoreApplication::translate("main", "Initial velocity, km/h"),
+                                    QCoreApplication::translate("main", "init-velocity"));
+
+    parser.addOption(initVelocity);
+
+    QCommandLineOption payloadCoeff(QStringList() << "p" << "payload",
+                                    QCoreApplication::translate("main", "Payload coefficient of all vehicles"),
+                                    QCoreApplication::translate("main", "payload-coeff"));
+
+    parser.addOption(payloadCoeff);
+
+    // Headless simulation as fast as possible
+    QCommandLineOption batchMode(QStringList() << "b" << "batch",
+                                 QCoreApplication::translate("main", "Batch simulation from start to stop time without real time pacing"));
+
+    parser.addOption(batchMode);
+
+    QCommandLineOption batchOutput(QStringList() << "batch-output",
+                                   QCoreApplication::translate("main", "Batch simulation output file"),
+                                   QCoreApplication::translate("main", "batch-output-file"));
+
+    parser.addOption(batchOutput);
+
+    QCommandLineOption controlScript(QStringList() << "control-script",
+                                     QCoreApplication::translate("main", "Timed keys events for batch simulation"),
+                                     QCoreApplication::translate("main", "control-script-file"));
+
+    parser.addOption(controlScript);
+
     // Parse command line arguments
     if (!parser.parse(this->arguments()))
     {
@@ -233,5 +269,36 @@ CommandLineParesrResult AppCore::parseCommandLine(QCommandLineParser &parser,
         command_line.direction.value = tmp.toInt();
     }
 
+    if (parser.isSet(initVelocity))
+    {
+        command_line.init_velocity.is_present = true;
+        QString tmp = parser.value(initVelocity);
+        command_line.init_velocity.value = tmp.toDouble();
+    }
+
+    if (parser.isSet(payloadCoeff))
+    {
+        command_line.payload_coeff.is_present = true;
+        QString tmp = parser.value(payloadCoeff);
+        command_line.payload_coeff.value = tmp.toDouble();
+    }
+
+    if (parser.isSet(batchMode))
+    {
+        command_line.batch_mode.is_present = command_line.batch_mode.value = true;
+    }
+
+    if (parser.isSet(batchOutput))
+    {
+        command_line.batch_output.is_present = true;
+        command_line.batch_output.value = parser.value(batchOutput);
+    }
+
+    if (parser.isSet(controlScript))
+    {
+        command_line.control_script.is_present = true;
+        command_line.control_script.value = parser.value(controlScript);
+    }
+
     return CommandLineOk;
 }
@@ -41,6 +41,14 @@ public:
     /// Calculation of right part ODE system
     virtual void calcDerivative(state_vector_t &Y, state_vector_t &dYdt, double t) = 0;
 
+    /*!
+     * \brief Bandwidth of Jacobian matrix (for implicit solvers)
+     * \param lower - number of subdiagonals
+     * \param upper - number of superdiagonals
+     * \return false, if Jacobian structure is unknown (dense matrix)
+     */
+    virtual bool getJacobianBandwidth(size_t &lower, size_t &upper) const;
+
 protected:
 
     /// ODE state vector
@@ -54,6 +54,20 @@ public:
                       double &dt,
                       double max_step,
                       double local_err) = 0;
+
+    /*!
+     * \brief Dense output of solution inside last accepted step
+     * \param t - time inside last step
+     * \param Y - interpolated state vector
+     * \return false, if method has no dense output or t is out of step
+     */
+    virtual bool getDenseOutput(double t, state_vector_t &Y)
+    {
+        Q_UNUSED(t)
+        Q_UNUSED(Y)
+
+        return false;
+    }
 };
 
 /*!
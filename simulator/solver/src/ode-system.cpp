@@ -15,3 +15,13 @@ OdeSystem::~OdeSystem()
 {
 
 }
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool OdeSystem::getJacobianBandwidth(size_t &lower, size_t &upper) const
+{
+    lower = upper = 0;
+
+    return false;
+}
@@ -5,6 +5,7 @@
 
 #include    <QObject>
 #include    <QMap>
+#include    <QMutex>
 
 #include    "sound-config.h"
 
@@ -27,6 +28,9 @@ private:
 
     QMap<QString, sound_config_t> sounds;
 
+    /// Sounds may be controlled by vehicles, integrated in parallel threads
+    QMutex  sounds_mutex;
+
     void attachSound(const QString &name, const QString &path);
 
 public slots:
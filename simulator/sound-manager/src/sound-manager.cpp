@@ -99,6 +99,8 @@ void SoundManager::attachSound(const QString &name, const QString &path)
 //------------------------------------------------------------------------------
 void SoundManager::play(QString name)
 {
+    QMutexLocker locker(&sounds_mutex);
+
     if ( name.isEmpty() || name.isNull() )
         return;
 
@@ -113,6 +115,8 @@ void SoundManager::play(QString name)
 //------------------------------------------------------------------------------
 void SoundManager::stop(QString name)
 {
+    QMutexLocker locker(&sounds_mutex);
+
     if ( name.isEmpty() || name.isNull() )
         return;
 
@@ -127,6 +131,8 @@ void SoundManager::stop(QString name)
 //------------------------------------------------------------------------------
 void SoundManager::setVolume(QString name, int volume)
 {
+    QMutexLocker locker(&sounds_mutex);
+
     if ( name.isEmpty() || name.isNull() )
         return;
 
@@ -159,6 +165,8 @@ void SoundManager::setVolume(QString name, int volume)
 //------------------------------------------------------------------------------
 void SoundManager::setPitch(QString name, float pitch)
 {
+    QMutexLocker locker(&sounds_mutex);
+
     if ( name.isEmpty() || name.isNull() )
         return;
 
@@ -183,6 +191,8 @@ void SoundManager::setPitch(QString name, float pitch)
 //------------------------------------------------------------------------------
 void SoundManager::volumeCurveStep(QString name, float param)
 {
+    QMutexLocker locker(&sounds_mutex);
+
     auto it = sounds.find(name);
 
     if (it.key() == name)
@@ -0,0 +1,54 @@
+//------------------------------------------------------------------------------
+//
+//      Table of batch simulation output
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Table of batch simulation output
+ * \copyright maisvendoo
+ */
+
+#ifndef     BATCH_TABLE_H
+#define     BATCH_TABLE_H
+
+#include    <QString>
+#include    <QStringList>
+#include    <vector>
+
+/*!
+ * \class
+ * \brief Columns of file, written by simulator in batch mode
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class BatchTable
+{
+public:
+
+    BatchTable();
+
+    ~BatchTable();
+
+    /// Load semicolon separated table with header
+    bool load(const QString &path);
+
+    /// Column index by name, -1 if column is absent
+    int getColumnIndex(const QString &name) const;
+
+    /// Column data
+    const std::vector<double> &getColumn(int idx) const;
+
+    /// Number of rows
+    size_t getRowsCount() const;
+
+private:
+
+    QStringList     names;
+
+    std::vector<std::vector<double>>    columns;
+};
+
+#endif // BATCH_TABLE_H
@@ -0,0 +1,166 @@
+//------------------------------------------------------------------------------
+//
+//      Parallel parameter sweep over batch simulations
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Parallel parameter sweep over batch simulations
+ * \copyright maisvendoo
+ */
+
+#ifndef     SWEEP_RUNNER_H
+#define     SWEEP_RUNNER_H
+
+#include    <QString>
+#include    <QStringList>
+#include    <vector>
+
+class BatchTable;
+class CfgReader;
+
+/*!
+ * \struct
+ * \brief One simulation of sweep
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct sweep_scenario_t
+{
+    QString train_config;
+    /// Payload coefficient (negative - from simulator config)
+    double  payload_coeff;
+    /// Initial velocity (negative - from simulator config)
+    double  init_velocity;
+    /// Control script path (empty - no control)
+    QString control_script;
+    /// Batch output file
+    QString output_path;
+    /// Simulator exit code
+    int     exit_code;
+    /// Calculated metrics
+    std::vector<double> metrics;
+
+    sweep_scenario_t()
+        : train_config("")
+        , payload_coeff(-1.0)
+        , init_velocity(-1.0)
+        , control_script("")
+        , output_path("")
+        , exit_code(-1)
+    {
+
+    }
+};
+
+/*!
+ * \struct
+ * \brief Scalar result, calculated from simulation output
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct sweep_metric_t
+{
+    enum
+    {
+        METRIC_MAX,
+        METRIC_MIN,
+        METRIC_MAX_ABS,
+        METRIC_FINAL,
+        METRIC_STOPPING_DISTANCE
+    };
+
+    QString name;
+    int     type;
+    /// Column of Max, Min, MaxAbs, Final metrics
+    QString column;
+    /// Coordinate column of stopping distance
+    QString coord;
+    /// Velocity column of stopping distance
+    QString velocity;
+    /// Brakes application time
+    double  start_time;
+    /// Velocity, which is treated as stop, m/s
+    double  stop_velocity;
+
+    sweep_metric_t()
+        : name("")
+        , type(METRIC_MAX)
+        , column("")
+        , coord("x_first")
+        , velocity("v_first")
+        , start_time(0.0)
+        , stop_velocity(0.01)
+    {
+
+    }
+};
+
+/*!
+ * \class
+ * \brief Runner of scenarios matrix
+ *
+ * Sweep config contains <Sweep> section with comma separated lists
+ * TrainConfigs, PayloadCoeffs, InitVelocities and ControlScripts. All
+ * combinations are simulated. Each scenario is separate simulator process
+ * in batch mode, so scenarios don't share any plugin state. Processes are
+ * run concurrently, one per core by default (Threads field). <Metric>
+ * sections describe report columns, which are calculated from batch
+ * output of each scenario
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class SweepRunner
+{
+public:
+
+    SweepRunner();
+
+    ~SweepRunner();
+
+    /// Load sweep config and build scenarios matrix
+    bool init(const QString &cfg_path, const QString &simulator_path);
+
+    /// Run all scenarios and write report
+    bool run();
+
+private:
+
+    /// Simulator executable
+    QString     simulator_path;
+
+    /// Directory for scenarios output
+    QString     output_dir;
+
+    /// Report file
+    QString     report_path;
+
+    /// Concurrent processes number
+    int         threads;
+
+    std::vector<sweep_scenario_t>   scenarios;
+
+    std::vector<sweep_metric_t>     metrics;
+
+    /// Matrix building
+    void buildScenarios(const QStringList &train_configs,
+                        const QStringList &payload_coeffs,
+                        const QStringList &init_velocities,
+                        const QStringList &control_scripts);
+
+    void loadMetrics(CfgReader &cfg);
+
+    /// Simulator launch for one scenario
+    void runScenario(sweep_scenario_t &scenario);
+
+    /// Metric value from scenario output
+    double calcMetric(const sweep_metric_t &metric, const BatchTable &table) const;
+
+    bool writeReport();
+};
+
+#endif // SWEEP_RUNNER_H
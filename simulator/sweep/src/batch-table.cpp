@@ -0,0 +1,99 @@
+//------------------------------------------------------------------------------
+//
+//      Table of batch simulation output
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Table of batch simulation output
+ * \copyright maisvendoo
+ */
+
+#include    "batch-table.h"
+
+#include    <QFile>
+#include    <QByteArray>
+#include    <QList>
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+BatchTable::BatchTable()
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+BatchTable::~BatchTable()
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool BatchTable::load(const QString &path)
+{
+    QFile file(path);
+
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    names.clear();
+    columns.clear();
+
+    QByteArray header = file.readLine().trimmed();
+
+    if (header.isEmpty())
+        return false;
+
+    for (const QByteArray &name : header.split(';'))
+        names << QString::fromUtf8(name);
+
+    columns.resize(static_cast<size_t>(names.size()));
+
+    while (!file.atEnd())
+    {
+        QByteArray line = file.readLine().trimmed();
+        QList<QByteArray> fields = line.split(';');
+
+        // Incomplete last row of aborted simulation is skipped
+        if (fields.size() != names.size())
+            continue;
+
+        for (int i = 0; i < fields.size(); ++i)
+            columns[static_cast<size_t>(i)].push_back(fields[i].toDouble());
+    }
+
+    return true;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int BatchTable::getColumnIndex(const QString &name) const
+{
+    return names.indexOf(name);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const std::vector<double> &BatchTable::getColumn(int idx) const
+{
+    return columns[static_cast<size_t>(idx)];
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+size_t BatchTable::getRowsCount() const
+{
+    if (columns.empty())
+        return 0;
+
+    return columns[0].size();
+}
@@ -0,0 +1,69 @@
+//------------------------------------------------------------------------------
+//
+//      Parallel parameter sweep over batch simulations
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Parallel parameter sweep over batch simulations
+ * \copyright maisvendoo
+ */
+
+#include    <QCoreApplication>
+#include    <QCommandLineParser>
+#include    <QDir>
+
+#include    "sweep-runner.h"
+#include    "filesystem.h"
+#include    "Journal.h"
+#include    "JournalFile.h"
+
+/*!
+ * \fn
+ * \brief Program entry point
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+
+    FileSystem &fs = FileSystem::getInstance();
+    QString log_path = QString(fs.combinePath(fs.getLogsDir(), "sweep.log").c_str());
+    Journal::instance()->addStorage( new JournalFile(log_path, JournalLevel::All) );
+
+    QCommandLineParser parser;
+    parser.addHelpOption();
+
+    QCommandLineOption simulatorPath(QStringList() << "s" << "simulator",
+                                     QCoreApplication::translate("main", "Simulator executable"),
+                                     QCoreApplication::translate("main", "simulator-path"));
+
+    parser.addOption(simulatorPath);
+    parser.addPositionalArgument("config", QCoreApplication::translate("main", "Sweep configuration"));
+
+    parser.process(app);
+
+    QString cfg_path = QString(fs.getConfigDir().c_str()) + fs.separator() + "sweep.xml";
+
+    if (!parser.positionalArguments().isEmpty())
+        cfg_path = parser.positionalArguments().at(0);
+
+#ifdef QT_DEBUG
+    QString simulator = QDir(app.applicationDirPath()).filePath("simulator_d");
+#else
+    QString simulator = QDir(app.applicationDirPath()).filePath("simulator");
+#endif
+
+    if (parser.isSet(simulatorPath))
+        simulator = parser.value(simulatorPath);
+
+    SweepRunner sweep;
+
+    if (!sweep.init(cfg_path, simulator))
+        return -1;
+
+    return sweep.run() ? 0 : 1;
+}
@@ -0,0 +1,407 @@
+//------------------------------------------------------------------------------
+//
+//      Parallel parameter sweep over batch simulations
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Parallel parameter sweep over batch simulations
+ * \copyright maisvendoo
+ */
+
+#include    "sweep-runner.h"
+
+#include    <QDir>
+#include    <QFile>
+#include    <QFileInfo>
+#include    <QProcess>
+#include    <QThread>
+
+#include    <atomic>
+#include    <cmath>
+#include    <limits>
+#include    <thread>
+
+#include    "CfgReader.h"
+#include    "Journal.h"
+#include    "filesystem.h"
+#include    "batch-table.h"
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+SweepRunner::SweepRunner()
+    : simulator_path("")
+    , output_dir("")
+    , report_path("")
+    , threads(0)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+SweepRunner::~SweepRunner()
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool SweepRunner::init(const QString &cfg_path, const QString &simulator_path)
+{
+    this->simulator_path = simulator_path;
+
+    CfgReader cfg;
+
+    if (!cfg.load(cfg_path))
+    {
+        Journal::instance()->error("File " + cfg_path + " not found");
+        return false;
+    }
+
+    FileSystem &fs = FileSystem::getInstance();
+    QString secName = "Sweep";
+
+    if (!cfg.getInt(secName, "Threads", threads) || (threads <= 0))
+    {
+        threads = QThread::idealThreadCount();
+    }
+
+    QString report_name = "sweep-report.csv";
+
+    if (!cfg.getString(secName, "Report", report_name))
+    {
+        report_name = "sweep-report.csv";
+    }
+
+    report_path = QString(fs.combinePath(fs.getLogsDir(), report_name.toStdString()).c_str());
+    output_dir = QString(fs.combinePath(fs.getLogsDir(), "sweep").c_str());
+
+    QString train_configs = "";
+    QString payload_coeffs = "";
+    QString init_velocities = "";
+    QString control_scripts = "";
+
+    if (!cfg.getString(secName, "TrainConfigs", train_configs))
+    {
+        Journal::instance()->error("There are no TrainConfigs in sweep config");
+        return false;
+    }
+
+    cfg.getString(secName, "PayloadCoeffs", payload_coeffs);
+    cfg.getString(secName, "InitVelocities", init_velocities);
+    cfg.getString(secName, "ControlScripts", control_scripts);
+
+    // Control scripts are searched relative to sweep config
+    QStringList scripts;
+    QDir cfg_dir = QFileInfo(cfg_path).absoluteDir();
+
+    for (QString script : control_scripts.split(",", QString::SkipEmptyParts))
+        scripts << cfg_dir.absoluteFilePath(script.trimmed());
+
+    buildScenarios(train_configs.split(",", QString::SkipEmptyParts),
+                   payload_coeffs.split(",", QString::SkipEmptyParts),
+                   init_velocities.split(",", QString::SkipEmptyParts),
+                   scripts);
+
+    loadMetrics(cfg);
+
+    Journal::instance()->info(QString("Sweep of %1 scenarios by %2 processes")
+                              .arg(scenarios.size())
+                              .arg(threads));
+
+    return !scenarios.empty();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool SweepRunner::run()
+{
+    QDir().mkpath(output_dir);
+
+    std::atomic<size_t> next_scenario(0);
+    std::atomic<size_t> finished(0);
+
+    auto worker = [&]()
+    {
+        size_t i = 0;
+
+        while ( (i = next_scenario.fetch_add(1)) < scenarios.size() )
+        {
+            runScenario(scenarios[i]);
+
+            Journal::instance()->info(QString("Scenario %1 finished with code %2 (%3 of %4)")
+                                      .arg(i)
+                                      .arg(scenarios[i].exit_code)
+                                      .arg(++finished)
+                                      .arg(scenarios.size()));
+        }
+    };
+
+    size_t num_threads = std::min(static_cast<size_t>(threads), scenarios.size());
+    std::vector<std::thread> pool;
+
+    for (size_t i = 0; i < num_threads; ++i)
+        pool.emplace_back(worker);
+
+    for (auto &thread : pool)
+        thread.join();
+
+    return writeReport();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void SweepRunner::buildScenarios(const QStringList &train_configs,
+                                 const QStringList &payload_coeffs,
+                                 const QStringList &init_velocities,
+                                 const QStringList &control_scripts)
+{
+    // Absent parameter is taken from simulator config
+    QStringList payloads = payload_coeffs.isEmpty() ? QStringList() << "-1" : payload_coeffs;
+    QStringList velocities = init_velocities.isEmpty() ? QStringList() << "-1" : init_velocities;
+    QStringList scripts = control_scripts.isEmpty() ? QStringList() << "" : control_scripts;
+
+    scenarios.clear();
+
+    for (const QString &train_config : train_configs)
+        for (const QString &payload : payloads)
+            for (const QString &velocity : velocities)
+                for (const QString &script : scripts)
+                {
+                    sweep_scenario_t scenario;
+
+                    scenario.train_config = train_config.trimmed();
+                    scenario.payload_coeff = payload.trimmed().toDouble();
+                    scenario.init_velocity = velocity.trimmed().toDouble();
+                    scenario.control_script = script;
+                    scenario.output_path = QDir(output_dir).filePath(
+                                QString("scenario-%1.csv").arg(scenarios.size()));
+
+                    scenarios.push_back(scenario);
+                }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void SweepRunner::loadMetrics(CfgReader &cfg)
+{
+    QDomNode metric_node = cfg.getFirstSection("Metric");
+
+    while (!metric_node.isNull())
+    {
+        sweep_metric_t metric;
+        QString type = "Max";
+
+        cfg.getString(metric_node, "Type", type);
+
+        if (type == "Min")
+            metric.type = sweep_metric_t::METRIC_MIN;
+        else if (type == "MaxAbs")
+            metric.type = sweep_metric_t::METRIC_MAX_ABS;
+        else if (type == "Final")
+            metric.type = sweep_metric_t::METRIC_FINAL;
+        else if (type == "StoppingDistance")
+            metric.type = sweep_metric_t::METRIC_STOPPING_DISTANCE;
+        else
+            metric.type = sweep_metric_t::METRIC_MAX;
+
+        cfg.getString(metric_node, "Column", metric.column);
+        cfg.getString(metric_node, "Coord", metric.coord);
+        cfg.getString(metric_node, "Velocity", metric.velocity);
+        cfg.getDouble(metric_node, "StartTime", metric.start_time);
+        cfg.getDouble(metric_node, "StopVelocity", metric.stop_velocity);
+
+        if (!cfg.getString(metric_node, "Name", metric.name))
+        {
+            metric.name = type + "(" + metric.column + ")";
+        }
+
+        metrics.push_back(metric);
+
+        metric_node = cfg.getNextSection();
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void SweepRunner::runScenario(sweep_scenario_t &scenario)
+{
+    QStringList args;
+
+    args << "--batch"
+         << "--batch-output" << scenario.output_path
+         << "--train-config" << scenario.train_config;
+
+    if (scenario.init_velocity >= 0)
+        args << "--init-velocity" << QString::number(scenario.init_velocity);
+
+    if (scenario.payload_coeff >= 0)
+        args << "--payload" << QString::number(scenario.payload_coeff);
+
+    if (!scenario.control_script.isEmpty())
+        args << "--control-script" << scenario.control_script;
+
+    // Table of previous sweep must not be taken for result of this one
+    QFile::remove(scenario.output_path);
+
+    QProcess process;
+    process.setStandardOutputFile(QProcess::nullDevice());
+    process.setStandardErrorFile(QProcess::nullDevice());
+    process.start(simulator_path, args);
+
+    if (!process.waitForStarted() || !process.waitForFinished(-1))
+    {
+        Journal::instance()->error("Can't run " + simulator_path + ": " + process.errorString());
+        scenario.exit_code = -1;
+    }
+    else
+    {
+        scenario.exit_code = (process.exitStatus() == QProcess::NormalExit) ? process.exitCode() : -1;
+    }
+
+    // Table of failed run may be incomplete, so its metrics aren't reported
+    BatchTable table;
+    bool is_loaded = (scenario.exit_code == 0) && table.load(scenario.output_path);
+
+    scenario.metrics.clear();
+
+    for (auto it = metrics.begin(); it != metrics.end(); ++it)
+    {
+        if (is_loaded)
+            scenario.metrics.push_back(calcMetric(*it, table));
+        else
+            scenario.metrics.push_back(std::numeric_limits<double>::quiet_NaN());
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+double SweepRunner::calcMetric(const sweep_metric_t &metric, const BatchTable &table) const
+{
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+
+    if (table.getRowsCount() == 0)
+        return nan;
+
+    if (metric.type == sweep_metric_t::METRIC_STOPPING_DISTANCE)
+    {
+        int t_idx = table.getColumnIndex("t");
+        int x_idx = table.getColumnIndex(metric.coord);
+        int v_idx = table.getColumnIndex(metric.velocity);
+
+        if ( (t_idx < 0) || (x_idx < 0) || (v_idx < 0) )
+            return nan;
+
+        const std::vector<double> &time = table.getColumn(t_idx);
+        const std::vector<double> &x = table.getColumn(x_idx);
+        const std::vector<double> &v = table.getColumn(v_idx);
+
+        size_t start = 0;
+
+        while ( (start < time.size()) && (time[start] < metric.start_time) )
+            start++;
+
+        for (size_t i = start; i < time.size(); ++i)
+        {
+            if (std::abs(v[i]) <= metric.stop_velocity)
+                return std::abs(x[i] - x[start]);
+        }
+
+        // Train is't stopped
+        return nan;
+    }
+
+    int idx = table.getColumnIndex(metric.column);
+
+    if (idx < 0)
+        return nan;
+
+    const std::vector<double> &column = table.getColumn(idx);
+
+    double value = column.front();
+
+    for (double c : column)
+    {
+        switch (metric.type)
+        {
+        case sweep_metric_t::METRIC_MIN:
+
+            value = std::min(value, c);
+            break;
+
+        case sweep_metric_t::METRIC_MAX_ABS:
+
+            value = std::max(std::abs(value), std::abs(c));
+            break;
+
+        case sweep_metric_t::METRIC_FINAL:
+
+            value = c;
+            break;
+
+        default:
+
+            value = std::max(value, c);
+            break;
+        }
+    }
+
+    return value;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool SweepRunner::writeReport()
+{
+    QFile file(report_path);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        Journal::instance()->error("Can't open report file " + report_path);
+        return false;
+    }
+
+    QString header = "scenario;train;payload;init_velocity;control_script;exit_code";
+
+    for (auto it = metrics.begin(); it != metrics.end(); ++it)
+        header += ";" + it->name;
+
+    file.write((header + "\n").toUtf8());
+
+    bool is_all_ok = true;
+
+    for (size_t i = 0; i < scenarios.size(); ++i)
+    {
+        const sweep_scenario_t &scenario = scenarios[i];
+
+        QString row = QString("%1;%2;%3;%4;%5;%6")
+                .arg(i)
+                .arg(scenario.train_config)
+                .arg(scenario.payload_coeff)
+                .arg(scenario.init_velocity)
+                .arg(QFileInfo(scenario.control_script).fileName())
+                .arg(scenario.exit_code);
+
+        for (double value : scenario.metrics)
+            row += ";" + (std::isnan(value) ? QString("") : QString::number(value, 'g', 10));
+
+        file.write((row + "\n").toUtf8());
+
+        is_all_ok = is_all_ok && (scenario.exit_code == 0);
+    }
+
+    Journal::instance()->info("Sweep report is written into " + report_path);
+
+    return is_all_ok;
+}
@@ -0,0 +1,38 @@
+TEMPLATE = app
+
+QT -= gui
+QT += core
+QT += xml
+
+CONFIG += c++11
+CONFIG += console
+CONFIG -= app_bundle
+
+DESTDIR += ../../../bin
+
+TARGET = sweep
+
+CONFIG(debug, debug|release) {
+
+    TARGET = $$join(TARGET,,,_d)
+
+    LIBS += -L../../../lib -lCfgReader_d
+    LIBS += -L../../../lib -lfilesystem_d
+    LIBS += -L../../../lib -lJournal_d
+
+} else {
+
+    LIBS += -L../../../lib -lCfgReader
+    LIBS += -L../../../lib -lfilesystem
+    LIBS += -L../../../lib -lJournal
+}
+
+INCLUDEPATH += ./include
+
+INCLUDEPATH += ../../common-headers/
+INCLUDEPATH += ../../CfgReader/include
+INCLUDEPATH += ../../filesystem/include
+INCLUDEPATH += ../../libJournal/include
+
+HEADERS += $$files(./include/*.h)
+SOURCES += $$files(./src/*.cpp)
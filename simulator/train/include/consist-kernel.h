@@ -0,0 +1,133 @@
+//------------------------------------------------------------------------------
+//
+//      Structure-of-arrays train's longitudinal dynamics kernel
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Structure-of-arrays train's longitudinal dynamics kernel
+ * \copyright maisvendoo
+ */
+
+#ifndef     CONSIST_KERNEL_H
+#define     CONSIST_KERNEL_H
+
+#include    <vector>
+
+#include    "solver-types.h"
+
+class Vehicle;
+class Coupling;
+class Profile;
+
+/*!
+ * \class
+ * \brief Longitudinal dynamics of whole consist in contiguous arrays
+ *
+ * Motion parameters of all vehicles are mirrored into arrays once at
+ * train initialization. Right part of motion ODE's is evaluated in plain
+ * loops over this arrays. Vehicles are accessed only once per step, to
+ * take theirs active/reactive forces and to return coupling forces and
+ * profile data.
+ *
+ * Kernel implements common vehicle's motion equations, so only vehicles,
+ * which use them (setNativeAcceleration(true)), are mirrored. Others are
+ * integrated through theirs calcAcceleration() with the same coupling
+ * forces and profile data
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class ConsistKernel
+{
+public:
+
+    /// Constructor
+    ConsistKernel();
+    /// Destructor
+    ~ConsistKernel();
+
+    /// Mirror vehicles motion parameters into arrays
+    void build(const std::vector<Vehicle *> &vehicles,
+               const std::vector<Coupling *> &couplings,
+               Profile *profile,
+               int dir);
+
+    /// Take forces and railway coordinates from vehicles before step
+    void preStep();
+
+    /// Calculation of right part motion ODE's
+    void calcDerivative(state_vector_t &Y, state_vector_t &dYdt, double t);
+
+    /// Return coupling forces and profile data to vehicles after step
+    void postStep();
+
+private:
+
+    /// Number of vehicles
+    size_t  n;
+
+    /// Railway motion direction
+    int     dir;
+
+    /// Pointers to source objects
+    std::vector<Vehicle *>  vehicles;
+    std::vector<Coupling *> couplings;
+    Profile                 *profile;
+
+    /// Vehicles with own acceleration calculation
+    std::vector<size_t> fallback;
+    /// Vehicle is mirrored into arrays
+    std::vector<bool>   is_mirrored;
+
+    /// Vehicle ODE system index
+    std::vector<size_t> idx;
+    /// Number of degrees of freedom
+    std::vector<size_t> s;
+    /// Index of first common force of vehicle in Q_a/Q_r arrays
+    std::vector<size_t> q_idx;
+
+    /// Full vehicle mass
+    std::vector<double> full_mass;
+    /// Equivalent mass (with axis inertia)
+    std::vector<double> eq_mass;
+    /// Half of vehicle length
+    std::vector<double> half_length;
+    /// Wheel radius
+    std::vector<double> rk;
+    /// Axis moment of inertia
+    std::vector<double> J_axis;
+    /// Number of axis
+    std::vector<size_t> num_axis;
+
+    /// Main resistence formula coefficients
+    std::vector<double> b0;
+    std::vector<double> b1;
+    std::vector<double> b2;
+    std::vector<double> b3;
+    std::vector<double> q0;
+
+    /// Profile element hints of vehicles
+    std::vector<size_t> profile_hint;
+    /// Vertical profile inclination
+    std::vector<double> inc;
+    /// Railway curvature
+    std::vector<double> curv;
+
+    /// Active common forces of all vehicles
+    std::vector<double> Q_a;
+    /// Reactive common forces of all vehicles
+    std::vector<double> Q_r;
+
+    /// Coupling forces
+    std::vector<double> R;
+    /// Gravity force from profile inclination
+    std::vector<double> G;
+    /// Curvature specific resistence
+    std::vector<double> wk;
+    /// Sum of forces acting on vehicle body
+    std::vector<double> F;
+};
+
+#endif // CONSIST_KERNEL_H
@@ -0,0 +1,124 @@
+//------------------------------------------------------------------------------
+//
+//      Multirate integration support
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Multirate integration support
+ * \copyright maisvendoo
+ */
+
+#ifndef     MULTIRATE_H
+#define     MULTIRATE_H
+
+#include    <vector>
+#include    <cstddef>
+
+/*!
+ * \struct
+ * \brief Group of subsystems, integrated with own fixed step
+ *
+ * Group with zero step is synchronous: it is integrated after train motion
+ * with the same step. Group with own step has own model time and goes
+ * ahead of train motion: it makes a step as soon as train motion reaches
+ * the group's time
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+struct rate_group_t
+{
+    /// Own integration step
+    double  step;
+    /// Own model time
+    double  t;
+
+    rate_group_t()
+        : step(0.0)
+        , t(0.0)
+    {
+
+    }
+
+    bool isSynchronous() const
+    {
+        return step <= 0.0;
+    }
+
+    bool isDue(double t_model) const
+    {
+        return t <= t_model;
+    }
+};
+
+/*!
+ * \class
+ * \brief Signal, transferred between subsystems with different rates
+ *
+ * Producer publishes samples at the end of each own step. Consumer gets
+ * value, linearly interpolated between two last samples. Outside sampled
+ * interval the nearest sample is used, so signal is never extrapolated
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class MultirateSignal
+{
+public:
+
+    MultirateSignal();
+
+    ~MultirateSignal();
+
+    /// Set signal size and fill both samples by initial value
+    void reset(size_t size, double t, double value = 0.0);
+
+    /// Start new sample at time t (previous sample is kept for interpolation)
+    void beginSample(double t);
+
+    /// Set value of current sample
+    void set(size_t i, double value)
+    {
+        v1[i] = value;
+    }
+
+    /// Get value of current sample
+    double last(size_t i) const
+    {
+        return v1[i];
+    }
+
+    /// Get interpolated value
+    double get(size_t i, double t) const
+    {
+        double theta = weight(t);
+        return v0[i] + theta * (v1[i] - v0[i]);
+    }
+
+    /// Get all interpolated values
+    void get(double t, double *values) const;
+
+    /// Interpolation weight of current sample at time t
+    double weight(double t) const;
+
+    /// Values of current sample
+    const double *lastData() const { return v1.data(); }
+
+    double *lastData() { return v1.data(); }
+
+    size_t size() const { return v1.size(); }
+
+private:
+
+    /// Time of previous sample
+    double  t0;
+    /// Time of current sample
+    double  t1;
+
+    std::vector<double> v0;
+    std::vector<double> v1;
+};
+
+#endif // MULTIRATE_H
@@ -0,0 +1,131 @@
+//------------------------------------------------------------------------------
+//
+//      Step profiler with per-thread timing histograms
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Step profiler with per-thread timing histograms
+ * \copyright maisvendoo
+ */
+
+#ifndef     STEP_PROFILER_H
+#define     STEP_PROFILER_H
+
+#include    <QtGlobal>
+#include    <QString>
+
+#include    <atomic>
+#include    <chrono>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+    #include    <intrin.h>
+    #define     PROFILER_RDTSC
+#elif defined(__x86_64__) || defined(__i386__)
+    #include    <x86intrin.h>
+    #define     PROFILER_RDTSC
+#endif
+
+#if defined(TRAIN_LIB)
+    #define TRAIN_EXPORT    Q_DECL_EXPORT
+#else
+    #define TRAIN_EXPORT    Q_DECL_IMPORT
+#endif
+
+/*!
+ * \enum
+ * \brief Profiled code sections
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+enum ProfilerSection
+{
+    PROF_MODEL_PROCESS,
+    PROF_TRAIN_STEP,
+    PROF_SOLVER,
+    PROF_BRAKEPIPE,
+    PROF_VEHICLES,
+    PROF_VEHICLE_STEP,
+    PROF_FEEDBACK,
+    PROF_CONTROL,
+    PROF_INPUT,
+    PROF_SECTIONS_NUM
+};
+
+//------------------------------------------------------------------------------
+//  Cycle counter (or nanoseconds on platforms without it)
+//------------------------------------------------------------------------------
+inline quint64 profilerTicks()
+{
+#if defined(PROFILER_RDTSC)
+    return static_cast<quint64>(__rdtsc());
+#else
+    return static_cast<quint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/*!
+ * \class
+ * \brief Collector of sections timings
+ *
+ * Each thread writes into own histograms, so recording takes no locks
+ * and no read-modify-write atomics. Histogram bucket k counts intervals
+ * from 2^k to 2^(k+1) ticks. Report merges histograms of all threads,
+ * while they are written
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class TRAIN_EXPORT StepProfiler
+{
+public:
+
+    /// Number of histogram buckets
+    static const size_t BUCKETS_NUM = 48;
+
+    /// Add section interval to histogram of current thread
+    static void record(int section, quint64 ticks);
+
+    /// Text report of all threads since start
+    static QString report();
+
+    /// Write report into file
+    static bool dump(const QString &path);
+
+    /*!
+     * \class
+     * \brief Measures time of scope
+     */
+    class Scope
+    {
+    public:
+
+        explicit Scope(int section)
+            : section(section)
+            , start(profilerTicks())
+        {
+
+        }
+
+        ~Scope()
+        {
+            StepProfiler::record(section, profilerTicks() - start);
+        }
+
+    private:
+
+        int     section;
+        quint64 start;
+    };
+};
+
+#if defined(STEP_PROFILER)
+    #define PROFILE_SCOPE(section) StepProfiler::Scope profiler_scope_##section(section)
+#else
+    #define PROFILE_SCOPE(section)
+#endif
+
+#endif // STEP_PROFILER_H
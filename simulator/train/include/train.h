@@ -24,8 +24,13 @@
 #include    "solver.h"
 #include    "solver-config.h"
 #include    "brakepipe.h"
+#include    "pipe-batch.h"
 #include    "profile.h"
 #include    "sound-manager.h"
+#include    "consist-kernel.h"
+#include    "multirate.h"
+#include    "worker-pool.h"
+#include    "step-profiler.h"
 
 #include    <QByteArray>
 
@@ -59,15 +64,24 @@ public:
     /// Calculation of right part motion ODE's
     void calcDerivative(state_vector_t &Y, state_vector_t &dYdt, double t);
 
+    /// Jacobian bandwidth of train motion ODE's
+    bool getJacobianBandwidth(size_t &lower, size_t &upper) const;
+
     /// Action before time step
     void preStep(double t);
 
     /// Integration step
     bool step(double t, double &dt);
 
+    /// Interpolated state vector inside last integration step
+    bool getDenseState(double t, state_vector_t &Y);
+
     /// Integration step for vehicles ODE's
     void vehiclesStep(double t, double dt);
 
+    /// Integration step for brakepipe
+    void brakepipeStep(double t, double dt);
+
     void inputProcess();
 
     /// Action after integration step
@@ -96,10 +110,12 @@ public:
 
     std::vector<Vehicle *> *getVehicles();
 
+    /// Share keyboard state with all vehicles
+    void setKeysState(const KeysState *keys);
+
 signals:
 
     void logMessage(QString msg);
-    void sendDataToVehicle(QByteArray data);
 
 private:    
 
@@ -123,15 +139,33 @@ private:
     /// No air flag (for empty air system on start)
     bool        no_air;
 
+    /// Use structure-of-arrays kernel for motion ODE's
+    bool        use_consist_kernel;
+
     /// Initial main reservoir pressure
     double      init_main_res_pressure;
 
+    /// Payload coefficient for all vehicles (negative - from train config)
+    double      payload_coeff_override;
+
     /// Motion ODE's solver
     Solver      *train_motion_solver;
 
     /// Brakepipe model
     BrakePipe   *brakepipe;    
 
+    /// Train's pipes, solved together
+    PipeBatch   pipes;
+
+    /// Structure-of-arrays motion ODE's kernel
+    ConsistKernel *consist_kernel;
+
+    /// Threads number for vehicles integration
+    int         vehicles_threads;
+
+    /// Thread pool for vehicles integration
+    WorkerPool  *vehicles_pool;
+
     /// Sound manager
     SoundManager *soundMan;
 
@@ -147,9 +181,34 @@ private:
     /// All train's couplings
     std::vector<Coupling *> couplings;
 
+    /// Profile element hints of vehicles, for profile search in O(1)
+    std::vector<size_t> profile_hints;
+
     /// Solver's configuration
     solver_config_t solver_config;
 
+    /// Brakepipe rate group
+    rate_group_t    brakepipe_rate;
+
+    /// Vehicles rate group
+    rate_group_t    vehicles_rate;
+
+    /// Brakepipe pressure in vehicle's nodes
+    MultirateSignal pTM_signal;
+
+    /// Vehicle's flow rate into brakepipe
+    MultirateSignal aux_rate_signal;
+
+    /// Pressure in begin of brakepipe
+    MultirateSignal p0_signal;
+
+    /// Vehicle's common forces (active forces at vehicle index,
+    /// reactive forces at vehicle index plus degrees of freedom)
+    MultirateSignal forces_signal;
+
+    /// Interpolated vehicle's common forces
+    state_vector_t  forces;
+
     /// Train's loading
     bool loadTrain(QString cfg_path);
     /// Couplings loading
@@ -160,6 +219,21 @@ private:
 
     /// Initialization of vehicles brakes
     void initVehiclesBrakes();
+
+    /// Initialization of rate groups and signals between them
+    void initMultirate(double t);
+
+    /// Steps of subsystems, which are integrated with own step
+    void multirateStep(double t);
+
+    /// Store vehicle's forces into current sample
+    void storeForces();
+
+    /// Sample brakepipe begin pressure and vehicles flows into brakepipe
+    void sampleBrakepipeInputs(double t);
+
+    /// Set vehicle's forces, interpolated at time t
+    void setInterpolatedForces(double t);
 };
 
 #endif // TRAIN_H
@@ -0,0 +1,112 @@
+//------------------------------------------------------------------------------
+//
+//      Fixed pool of worker threads for parallel loops
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Fixed pool of worker threads for parallel loops
+ * \copyright maisvendoo
+ */
+
+#ifndef     WORKER_POOL_H
+#define     WORKER_POOL_H
+
+#include    <vector>
+#include    <memory>
+#include    <thread>
+#include    <mutex>
+#include    <atomic>
+#include    <condition_variable>
+
+/*!
+ * \class
+ * \brief Pool of threads, which performs parallel loop over indices
+ *
+ * Index range is divided between workers. Each worker takes indices from
+ * own part, and after that it steals indices from parts of other workers.
+ * Calling thread works too, so pool of N threads has N - 1 own threads.
+ * Loop call returns when all indices are processed, so it is a barrier
+ */
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+class WorkerPool
+{
+public:
+
+    /// Constructor
+    explicit WorkerPool(size_t threads_num);
+    /// Destructor
+    ~WorkerPool();
+
+    /// Get threads number (including calling thread)
+    size_t getThreadsNum() const;
+
+    /// Call func(i) for all i from 0 to n - 1
+    template <typename Func>
+    void parallelFor(size_t n, Func &func)
+    {
+        run(n, &func, [](void *ctx, size_t i) {
+            (*static_cast<Func *>(ctx))(i);
+        });
+    }
+
+private:
+
+    /// Part of index range, owned by worker
+    struct worker_queue_t
+    {
+        std::atomic<size_t> next;
+        size_t              end;
+
+        /// Separate counters of workers by cache line
+        char padding[64 - sizeof(std::atomic<size_t>) - sizeof(size_t)];
+
+        worker_queue_t()
+            : next(0)
+            , end(0)
+        {
+
+        }
+    };
+
+    /// Threads number (including calling thread)
+    size_t  threads_num;
+
+    /// Own threads of pool
+    std::vector<std::thread> threads;
+
+    /// Parts of index range
+    std::unique_ptr<worker_queue_t[]> queues;
+
+    std::mutex  mutex;
+    std::condition_variable start_cond;
+    std::condition_variable done_cond;
+
+    /// Loop counter, workers start when it is changed
+    size_t  generation;
+    /// Number of workers, which are busy with current loop
+    size_t  active;
+    /// Pool stop flag
+    bool    is_stopped;
+
+    /// Loop body call
+    typedef void (*task_call_t)(void *ctx, size_t i);
+
+    /// Current loop body
+    void        *task_ctx;
+    task_call_t task_call;
+
+    /// Parallel loop
+    void run(size_t n, void *ctx, task_call_t call);
+
+    /// Worker thread function
+    void loop(size_t w);
+
+    /// Process own and stolen indices
+    void work(size_t w);
+};
+
+#endif // WORKER_POOL_H
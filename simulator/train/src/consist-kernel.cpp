@@ -0,0 +1,261 @@
+//------------------------------------------------------------------------------
+//
+//      Structure-of-arrays train's longitudinal dynamics kernel
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Structure-of-arrays train's longitudinal dynamics kernel
+ * \copyright maisvendoo
+ */
+
+#include    "consist-kernel.h"
+
+#include    "vehicle.h"
+#include    "coupling.h"
+#include    "profile.h"
+#include    "physics.h"
+#include    "Journal.h"
+
+#include    <cstring>
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+ConsistKernel::ConsistKernel()
+    : n(0)
+    , dir(1)
+    , profile(nullptr)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+ConsistKernel::~ConsistKernel()
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void ConsistKernel::build(const std::vector<Vehicle *> &vehicles,
+                          const std::vector<Coupling *> &couplings,
+                          Profile *profile,
+                          int dir)
+{
+    this->vehicles = vehicles;
+    this->couplings = couplings;
+    this->profile = profile;
+    this->dir = dir;
+
+    n = vehicles.size();
+
+    idx.resize(n);
+    s.resize(n);
+    q_idx.resize(n);
+
+    full_mass.resize(n);
+    eq_mass.resize(n);
+    half_length.resize(n);
+    rk.resize(n);
+    J_axis.resize(n);
+    num_axis.resize(n);
+
+    b0.resize(n);
+    b1.resize(n);
+    b2.resize(n);
+    b3.resize(n);
+    q0.resize(n);
+
+    fallback.clear();
+    is_mirrored.assign(n, true);
+
+    profile_hint.assign(n, 0);
+    inc.resize(n);
+    curv.resize(n);
+
+    R.resize(n + 1);
+    G.resize(n);
+    wk.resize(n);
+    F.resize(n);
+
+    size_t q_size = 0;
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vehicle *vehicle = vehicles[i];
+
+        idx[i] = vehicle->getIndex();
+        s[i] = vehicle->getDegressOfFreedom();
+        q_idx[i] = q_size;
+        q_size += s[i];
+
+        full_mass[i] = vehicle->getMass();
+        half_length[i] = vehicle->getLength() / 2;
+        rk[i] = vehicle->getWheelRadius();
+        J_axis[i] = vehicle->getAxisInertia();
+        num_axis[i] = vehicle->getNumAxis();
+
+        eq_mass[i] = full_mass[i] + num_axis[i] * J_axis[i] / rk[i] / rk[i];
+
+        vehicle->getMainResist(b0[i], b1[i], b2[i], b3[i], q0[i]);
+
+        inc[i] = curv[i] = 0.0;
+
+        // Module may override acceleration calculation
+        if (!vehicle->isNativeAcceleration())
+        {
+            is_mirrored[i] = false;
+            fallback.push_back(i);
+
+            Journal::instance()->warning(QString("Vehicle %1 (%2) doesn't use native acceleration, "
+                                                 "it is integrated through own calcAcceleration()")
+                                         .arg(i)
+                                         .arg(vehicle->getConfigDir()));
+        }
+    }
+
+    Q_a.resize(q_size, 0.0);
+    Q_r.resize(q_size, 0.0);
+
+    // First vehicle has no forward coupling, last one - backward coupling
+    std::fill(R.begin(), R.end(), 0.0);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void ConsistKernel::preStep()
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vehicle *vehicle = vehicles[i];
+
+        const state_vector_t &Qa = vehicle->getActiveCommonForces();
+        const state_vector_t &Qr = vehicle->getReactiveCommonForces();
+
+        memcpy(Q_a.data() + q_idx[i], Qa.data(), sizeof(double) * s[i]);
+        memcpy(Q_r.data() + q_idx[i], Qr.data(), sizeof(double) * s[i]);
+
+        // Railway coordinate is updated only after integration step,
+        // so profile data are constant while step is performed
+        profile_element_t pe = profile->getElement(vehicle->getRailwayCoord(), profile_hint[i]);
+
+        inc[i] = pe.inclination;
+        curv[i] = pe.curvature;
+    }
+
+    for (size_t i : fallback)
+    {
+        vehicles[i]->setInclination(inc[i]);
+        vehicles[i]->setCurvature(curv[i]);
+    }
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        G[i] = full_mass[i] * Physics::g * inc[i] / 1000.0;
+        wk[i] = 700.0 * curv[i];
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void ConsistKernel::calcDerivative(state_vector_t &Y, state_vector_t &dYdt, double t)
+{
+    const double *y = Y.data();
+    double *dydt = dYdt.data();
+
+    // Coupling forces. R[i + 1] acts between vehicles i and i + 1
+    for (size_t i = 0; i + 1 < n; ++i)
+    {
+        size_t j = i + 1;
+
+        double ds = y[idx[i]] - y[idx[j]] - dir * half_length[i] - dir * half_length[j];
+        double dv = y[idx[i] + s[i]] - y[idx[j] + s[j]];
+
+        R[j] = dir * couplings[i]->getForce(ds, dv);
+    }
+
+    // Forces acting on vehicles bodies
+    for (size_t i = 0; i < n; ++i)
+    {
+        double v = y[idx[i] + s[i]];
+        double V = abs(v) * Physics::kmh;
+
+        double w = b0[i] + (b1[i] + b2[i] * V + b3[i] * V * V) / q0[i];
+        double W = full_mass[i] * Physics::g * (w + wk[i]) / 1000.0;
+
+        double Fr = Physics::fricForce(W + Q_r[q_idx[i]], dir * v);
+
+        F[i] = Q_a[q_idx[i]] - Fr + R[i] - R[i + 1] - G[i];
+    }
+
+    // Equivalent wheel forces
+    for (size_t i = 0; i < n; ++i)
+    {
+        const double *Qa = Q_a.data() + q_idx[i];
+        const double *Qr = Q_r.data() + q_idx[i];
+        const double *omega = y + idx[i] + s[i];
+
+        double sumEqWheelForce = 0;
+
+        for (size_t j = 1; j <= num_axis[i]; ++j)
+            sumEqWheelForce += (Qa[j] - Physics::fricForce(Qr[j], dir * omega[j])) / rk[i];
+
+        F[i] += sumEqWheelForce;
+    }
+
+    // Velocities and accelerations
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (!is_mirrored[i])
+            continue;
+
+        double *d = dydt + idx[i];
+        size_t si = s[i];
+
+        memcpy(d, y + idx[i] + si, sizeof(double) * si);
+
+        double a = dir * F[i] / eq_mass[i];
+        double eps = a / rk[i];
+
+        d[si] = a;
+
+        for (size_t j = 1; j < si; ++j)
+            d[si + j] = eps;
+    }
+
+    // Vehicles with own acceleration calculation
+    for (size_t i : fallback)
+    {
+        Vehicle *vehicle = vehicles[i];
+        size_t si = s[i];
+
+        vehicle->setForwardForce(R[i]);
+        vehicle->setBackwardForce(R[i + 1]);
+
+        memcpy(dydt + idx[i], y + idx[i] + si, sizeof(double) * si);
+        vehicle->calcAcceleration(Y, t, dydt + idx[i] + si);
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void ConsistKernel::postStep()
+{
+    for (size_t i = 0; i < n; ++i)
+    {
+        Vehicle *vehicle = vehicles[i];
+
+        vehicle->setForwardForce(R[i]);
+        vehicle->setBackwardForce(R[i + 1]);
+        vehicle->setInclination(inc[i]);
+        vehicle->setCurvature(curv[i]);
+    }
+}
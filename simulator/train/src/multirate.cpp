@@ -0,0 +1,80 @@
+//------------------------------------------------------------------------------
+//
+//      Multirate integration support
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Multirate integration support
+ * \copyright maisvendoo
+ */
+
+#include    "multirate.h"
+
+#include    <algorithm>
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+MultirateSignal::MultirateSignal()
+    : t0(0.0)
+    , t1(0.0)
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+MultirateSignal::~MultirateSignal()
+{
+
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MultirateSignal::reset(size_t size, double t, double value)
+{
+    v0.assign(size, value);
+    v1.assign(size, value);
+
+    t0 = t1 = t;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MultirateSignal::beginSample(double t)
+{
+    v0.swap(v1);
+    std::copy(v0.begin(), v0.end(), v1.begin());
+
+    t0 = t1;
+    t1 = t;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void MultirateSignal::get(double t, double *values) const
+{
+    double theta = weight(t);
+
+    for (size_t i = 0; i < v1.size(); ++i)
+        values[i] = v0[i] + theta * (v1[i] - v0[i]);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+double MultirateSignal::weight(double t) const
+{
+    if (t1 <= t0)
+        return 1.0;
+
+    double theta = (t - t0) / (t1 - t0);
+
+    return std::max(0.0, std::min(1.0, theta));
+}
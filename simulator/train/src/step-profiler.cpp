@@ -0,0 +1,243 @@
+//------------------------------------------------------------------------------
+//
+//      Step profiler with per-thread timing histograms
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Step profiler with per-thread timing histograms
+ * \copyright maisvendoo
+ */
+
+#include    "step-profiler.h"
+
+#include    <QFile>
+
+#include    <algorithm>
+
+#include    <memory>
+#include    <mutex>
+#include    <vector>
+
+//------------------------------------------------------------------------------
+//  Histogram of one section. Only owner thread writes it
+//------------------------------------------------------------------------------
+struct section_hist_t
+{
+    std::atomic<quint64>    count;
+    std::atomic<quint64>    sum;
+    std::atomic<quint64>    max;
+    std::atomic<quint64>    buckets[StepProfiler::BUCKETS_NUM];
+
+    section_hist_t()
+        : count(0)
+        , sum(0)
+        , max(0)
+    {
+        for (size_t i = 0; i < StepProfiler::BUCKETS_NUM; ++i)
+            buckets[i].store(0, std::memory_order_relaxed);
+    }
+};
+
+struct thread_hist_t
+{
+    section_hist_t  sections[PROF_SECTIONS_NUM];
+};
+
+//------------------------------------------------------------------------------
+//  Histograms of all threads. Lock is taken only on thread registration
+//  and on report
+//------------------------------------------------------------------------------
+struct profiler_registry_t
+{
+    std::mutex  mutex;
+    std::vector<std::unique_ptr<thread_hist_t>> threads;
+
+    /// Ticks and time of profiler start, for ticks calibration
+    quint64     start_ticks;
+    std::chrono::steady_clock::time_point   start_time;
+
+    profiler_registry_t()
+        : start_ticks(profilerTicks())
+        , start_time(std::chrono::steady_clock::now())
+    {
+
+    }
+};
+
+static profiler_registry_t &registry()
+{
+    static profiler_registry_t instance;
+    return instance;
+}
+
+static thread_hist_t *threadHistograms()
+{
+    thread_local thread_hist_t *hist = nullptr;
+
+    if (hist == nullptr)
+    {
+        profiler_registry_t &reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+
+        reg.threads.emplace_back(new thread_hist_t());
+        hist = reg.threads.back().get();
+    }
+
+    return hist;
+}
+
+//------------------------------------------------------------------------------
+//  Index of highest set bit (zero for zero value)
+//------------------------------------------------------------------------------
+static inline size_t highestBit(quint64 value)
+{
+    value |= 1;
+
+#if defined(_MSC_VER) && defined(_M_X64)
+    unsigned long idx = 0;
+    _BitScanReverse64(&idx, value);
+    return static_cast<size_t>(idx);
+#elif defined(__GNUC__)
+    return static_cast<size_t>(63 - __builtin_clzll(value));
+#else
+    size_t idx = 0;
+
+    while (value >>= 1)
+        idx++;
+
+    return idx;
+#endif
+}
+
+static const char *section_names[PROF_SECTIONS_NUM] =
+{
+    "Model::process",
+    "Train::step",
+    "solver",
+    "brakepipe",
+    "vehicles",
+    "Vehicle::integrationStep",
+    "feedback",
+    "controlStep",
+    "inputProcess"
+};
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void StepProfiler::record(int section, quint64 ticks)
+{
+    section_hist_t &hist = threadHistograms()->sections[section];
+
+    size_t bucket = std::min(highestBit(ticks), BUCKETS_NUM - 1);
+
+    // Single writer, so plain load and store are enough
+    hist.count.store(hist.count.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+    hist.sum.store(hist.sum.load(std::memory_order_relaxed) + ticks, std::memory_order_relaxed);
+    hist.buckets[bucket].store(hist.buckets[bucket].load(std::memory_order_relaxed) + 1,
+                               std::memory_order_relaxed);
+
+    if (ticks > hist.max.load(std::memory_order_relaxed))
+        hist.max.store(ticks, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+QString StepProfiler::report()
+{
+    profiler_registry_t &reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+
+    // Ticks to microseconds
+    double elapsed_us = std::chrono::duration<double, std::micro>(
+                std::chrono::steady_clock::now() - reg.start_time).count();
+    quint64 elapsed_ticks = profilerTicks() - reg.start_ticks;
+    double us_per_tick = (elapsed_ticks != 0) ? elapsed_us / static_cast<double>(elapsed_ticks) : 0.0;
+
+    QString text = QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+            .arg(QString("section"), -26)
+            .arg(QString("threads"), 8)
+            .arg(QString("count"), 12)
+            .arg(QString("total,ms"), 12)
+            .arg(QString("mean,us"), 10)
+            .arg(QString("p50,us"), 10)
+            .arg(QString("p99,us"), 10)
+            .arg(QString("max,us"), 10);
+
+    for (int s = 0; s < PROF_SECTIONS_NUM; ++s)
+    {
+        quint64 count = 0;
+        quint64 sum = 0;
+        quint64 max = 0;
+        int threads = 0;
+        std::vector<quint64> buckets(BUCKETS_NUM, 0);
+
+        for (auto &thread : reg.threads)
+        {
+            const section_hist_t &hist = thread->sections[s];
+            quint64 c = hist.count.load(std::memory_order_relaxed);
+
+            if (c == 0)
+                continue;
+
+            threads++;
+            count += c;
+            sum += hist.sum.load(std::memory_order_relaxed);
+            max = std::max(max, hist.max.load(std::memory_order_relaxed));
+
+            for (size_t b = 0; b < BUCKETS_NUM; ++b)
+                buckets[b] += hist.buckets[b].load(std::memory_order_relaxed);
+        }
+
+        if (count == 0)
+            continue;
+
+        // Percentile is estimated by upper bound of bucket
+        auto percentile = [&buckets, count](double p) -> quint64
+        {
+            quint64 rank = static_cast<quint64>(p * static_cast<double>(count));
+            quint64 acc = 0;
+
+            for (size_t b = 0; b < buckets.size(); ++b)
+            {
+                acc += buckets[b];
+
+                if (acc > rank)
+                    return static_cast<quint64>(2) << b;
+            }
+
+            return static_cast<quint64>(2) << (buckets.size() - 1);
+        };
+
+        text += QString("%1 %2 %3 %4 %5 %6 %7 %8\n")
+                .arg(QString(section_names[s]), -26)
+                .arg(threads, 8)
+                .arg(count, 12)
+                .arg(static_cast<double>(sum) * us_per_tick / 1000.0, 12, 'f', 1)
+                .arg(static_cast<double>(sum) / static_cast<double>(count) * us_per_tick, 10, 'f', 2)
+                .arg(static_cast<double>(std::min(percentile(0.5), max)) * us_per_tick, 10, 'f', 2)
+                .arg(static_cast<double>(std::min(percentile(0.99), max)) * us_per_tick, 10, 'f', 2)
+                .arg(static_cast<double>(max) * us_per_tick, 10, 'f', 2);
+    }
+
+    return text;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool StepProfiler::dump(const QString &path)
+{
+    QFile file(path);
+
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+        return false;
+
+    file.write(report().toUtf8());
+    file.close();
+
+    return true;
+}
@@ -3,6 +3,7 @@
 #include    "CfgReader.h"
 #include    "physics.h"
 #include    "Journal.h"
+#include    "module-registry.h"
 
 //------------------------------------------------------------------------------
 //
@@ -15,9 +16,14 @@ Train::Train(Profile *profile, QObject *parent) : OdeSystem(parent)
   , profile(profile)
   , charging_pressure(0.0)
   , no_air(false)
+  , use_consist_kernel(false)
   , init_main_res_pressure(0.0)
+  , payload_coeff_override(-1.0)
   , train_motion_solver(nullptr)
   , brakepipe(nullptr)
+  , consist_kernel(nullptr)
+  , vehicles_threads(1)
+  , vehicles_pool(nullptr)
   , soundMan(nullptr)
 {
 
@@ -28,7 +34,8 @@ Train::Train(Profile *profile, QObject *parent) : OdeSystem(parent)
 //------------------------------------------------------------------------------
 Train::~Train()
 {
-
+    delete vehicles_pool;
+    delete consist_kernel;
 }
 
 //------------------------------------------------------------------------------
@@ -40,6 +47,8 @@ bool Train::init(const init_data_t &init_data)
 
     dir = init_data.direction;
 
+    payload_coeff_override = init_data.payload_coeff;
+
     // Solver loading
     FileSystem &fs = FileSystem::getInstance();
     QString solver_path = QString(fs.getLibraryDir().c_str()) + fs.separator() + solver_config.method;
@@ -63,16 +72,23 @@ bool Train::init(const init_data_t &init_data)
 
     Journal::instance()->info("Train config from file: " + full_config_path);
 
-    try
+    if (init_data.sound_enabled)
     {
-        soundMan = new SoundManager();
+        try
+        {
+            soundMan = new SoundManager();
 
-        Journal::instance()->info(QString("Created SoundManager at address: 0x%1")
-                                      .arg(reinterpret_cast<quint64>(soundMan), 0, 16));
+            Journal::instance()->info(QString("Created SoundManager at address: 0x%1")
+                                          .arg(reinterpret_cast<quint64>(soundMan), 0, 16));
 
-    } catch (const std::bad_alloc &)
+        } catch (const std::bad_alloc &)
+        {
+            Journal::instance()->error("Sound mamager is;t created");
+        }
+    }
+    else
     {
-        Journal::instance()->error("Sound mamager is;t created");
+        Journal::instance()->info("Sound is disabled");
     }
 
     // Loading of train
@@ -104,10 +120,23 @@ bool Train::init(const init_data_t &init_data)
         return false;
     }
 
+    // Vehicles, devices and couplings modules are loaded
+    ModuleRegistry::instance()->report();
+
     // Set initial conditions
     Journal::instance()->info("Setting up of initial conditions");
     setInitConditions(init_data);
 
+    profile_hints.assign(vehicles.size(), 0);
+
+    if (use_consist_kernel)
+    {
+        consist_kernel = new ConsistKernel();
+        consist_kernel->build(vehicles, couplings, profile, dir);
+
+        Journal::instance()->info("Motion ODE's are solved by structure-of-arrays kernel");
+    }
+
     // Brakepipe initialization
     brakepipe = new BrakePipe();
 
@@ -122,8 +151,28 @@ bool Train::init(const init_data_t &init_data)
 
     brakepipe->init(QString(fs.getConfigDir().c_str()) + fs.separator() + "brakepipe.xml");
 
+    Journal::instance()->info(QString("Brakepipe grid: %1 nodes for %2 vehicles")
+                              .arg(brakepipe->getGridNodesNum())
+                              .arg(vehicles.size()));
+
+    pipes.addPipe(brakepipe);
+
     initVehiclesBrakes();
 
+    initMultirate(solver_config.start_time);
+
+    if (vehicles_threads > 1)
+    {
+        vehicles_pool = new WorkerPool(static_cast<size_t>(vehicles_threads));
+
+        Journal::instance()->info(QString("Vehicles are integrated by %1 threads")
+                                  .arg(vehicles_threads));
+
+        Journal::instance()->warning("Vehicles are stepped concurrently: modules, which "
+                                     "access neighbour vehicles or shared state in step(), "
+                                     "give non-deterministic results. Set VehiclesThreads = 1 for them");
+    }
+
     return true;
 }
 
@@ -132,6 +181,12 @@ bool Train::init(const init_data_t &init_data)
 //------------------------------------------------------------------------------
 void Train::calcDerivative(state_vector_t &Y, state_vector_t &dYdt, double t)
 {
+    if (consist_kernel != Q_NULLPTR)
+    {
+        consist_kernel->calcDerivative(Y, dYdt, t);
+        return;
+    }
+
     size_t num_vehicles = vehicles.size();
     auto end = vehicles.end();
     auto coup_it = couplings.begin();
@@ -162,16 +217,39 @@ void Train::calcDerivative(state_vector_t &Y, state_vector_t &dYdt, double t)
             vehicle1->setForwardForce(R);
         }
 
-        profile_element_t pe = profile->getElement(vehicle->getRailwayCoord());
+        size_t &hint = profile_hints[static_cast<size_t>(it - vehicles.begin())];
+        profile_element_t pe = profile->getElement(vehicle->getRailwayCoord(), hint);
 
         vehicle->setInclination(pe.inclination);
         vehicle->setCurvature(pe.curvature);
 
-        state_vector_t a = vehicle->getAcceleration(Y, t);
-
         memcpy(dYdt.data() + idx, Y.data() + idx + s, sizeof(double) * s);
-        memcpy(dYdt.data() + idx + s, a.data(), sizeof(double) * s);
+        vehicle->calcAcceleration(Y, t, dYdt.data() + idx + s);
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool Train::getJacobianBandwidth(size_t &lower, size_t &upper) const
+{
+    // Vehicle's equations depend on own state and, through couplings,
+    // on state of neighbour vehicles only. So Jacobian is block tridiagonal
+    size_t width = 0;
+
+    for (size_t i = 0; i < vehicles.size(); ++i)
+    {
+        size_t w = 2 * vehicles[i]->getDegressOfFreedom();
+
+        if (i + 1 < vehicles.size())
+            w += 2 * vehicles[i + 1]->getDegressOfFreedom();
+
+        width = std::max(width, w - 1);
     }
+
+    lower = upper = width;
+
+    return !vehicles.empty();
 }
 
 //------------------------------------------------------------------------------
@@ -187,41 +265,122 @@ void Train::preStep(double t)
 //------------------------------------------------------------------------------
 bool Train::step(double t, double &dt)
 {
+    PROFILE_SCOPE(PROF_TRAIN_STEP);
+
+    // Subsystems with own step go ahead of train motion
+    multirateStep(t);
+
+    if (consist_kernel != Q_NULLPTR)
+        consist_kernel->preStep();
+
     // Train dynamics simulation
-    bool done = train_motion_solver->step(this, y, dydt, t, dt,
-                                          solver_config.max_step,
-                                          solver_config.local_error);    
-    // Brakepipe simulation
-    brakepipe->step(t, dt);
+    bool done = false;
 
-    vehiclesStep(t, dt);
+    {
+        PROFILE_SCOPE(PROF_SOLVER);
+
+        done = train_motion_solver->step(this, y, dydt, t, dt,
+                                         solver_config.max_step,
+                                         solver_config.local_error);
+    }
+
+    if (consist_kernel != Q_NULLPTR)
+        consist_kernel->postStep();
+
+    // Subsystems, synchronous with train motion
+    if (brakepipe_rate.isSynchronous())
+        brakepipeStep(t, dt);
+
+    if (vehicles_rate.isSynchronous())
+        vehiclesStep(t, dt);
 
     return done;
 }
 
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool Train::getDenseState(double t, state_vector_t &Y)
+{
+    return train_motion_solver->getDenseOutput(t, Y);
+}
+
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
 void Train::vehiclesStep(double t, double dt)
 {
-    auto end = vehicles.end();
-    auto begin = vehicles.begin();
+    PROFILE_SCOPE(PROF_VEHICLES);
 
-    brakepipe->setBeginPressure((*begin)->getBrakepipeBeginPressure());
-    size_t j = 1;
+    bool is_multirate = !vehicles_rate.isSynchronous();
 
-    for (auto i = begin; i != end; ++i)
+    auto vehicle_step = [this, t, dt, is_multirate](size_t i)
     {
-        Vehicle *vehicle = *i;
+        Vehicle *vehicle = vehicles[i];
+
+        // Vehicle continues from own forces, not from interpolated ones
+        if (is_multirate)
+        {
+            size_t idx = vehicle->getIndex();
+            size_t s = vehicle->getDegressOfFreedom();
 
-        brakepipe->setAuxRate(j, vehicle->getBrakepipeAuxRate());
-        vehicle->setBrakepipePressure(brakepipe->getPressure(j));
+            vehicle->setCommonForces(forces_signal.lastData() + idx,
+                                     forces_signal.lastData() + idx + s);
+        }
+
+        vehicle->setBrakepipePressure(pTM_signal.get(i, t + dt));
+
+        PROFILE_SCOPE(PROF_VEHICLE_STEP);
         vehicle->integrationStep(y, t, dt);
+    };
 
-        ++j;
+    // Synchronous brakepipe gets flows, which vehicles had before this
+    // step, as it always did
+    if (!is_multirate)
+        sampleBrakepipeInputs(t);
+
+    // Vehicles exchange data with brakepipe only before and after this
+    // loop. Concurrent integration also requires, that vehicle modules don't
+    // access neighbours (prev_vehicle, next_vehicle) in step(), see vehicle.h
+    if (vehicles_pool != Q_NULLPTR)
+    {
+        vehicles_pool->parallelFor(vehicles.size(), vehicle_step);
+    }
+    else
+    {
+        for (size_t i = 0; i < vehicles.size(); ++i)
+            vehicle_step(i);
+    }
+
+    if (is_multirate)
+    {
+        sampleBrakepipeInputs(t + dt);
+
+        forces_signal.beginSample(t + dt);
+        storeForces();
     }
 }
 
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Train::brakepipeStep(double t, double dt)
+{
+    PROFILE_SCOPE(PROF_BRAKEPIPE);
+
+    brakepipe->setBeginPressure(p0_signal.get(0, t + dt));
+
+    for (size_t i = 0; i < vehicles.size(); ++i)
+        brakepipe->setAuxRate(i + 1, aux_rate_signal.get(i, t + dt));
+
+    pipes.step(t, dt);
+
+    pTM_signal.beginSample(t + dt);
+
+    for (size_t i = 0; i < vehicles.size(); ++i)
+        pTM_signal.set(i, brakepipe->getPressure(i + 1));
+}
+
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
@@ -333,6 +492,15 @@ std::vector<Vehicle *> *Train::getVehicles()
     return &vehicles;
 }
 
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Train::setKeysState(const KeysState *keys)
+{
+    for (auto it = vehicles.begin(); it != vehicles.end(); ++it)
+        (*it)->setKeysState(keys);
+}
+
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
@@ -361,6 +529,16 @@ bool Train::loadTrain(QString cfg_path)
             no_air = false;
         }
 
+        if (!cfg.getBool("Common", "ConsistKernel", use_consist_kernel))
+        {
+            use_consist_kernel = false;
+        }
+
+        if (!cfg.getInt("Common", "VehiclesThreads", vehicles_threads))
+        {
+            vehicles_threads = 1;
+        }
+
         if (!cfg.getString("Common", "ClientName", client_name))
         {
             client_name = "";
@@ -412,6 +590,9 @@ bool Train::loadTrain(QString cfg_path)
                 payload_coeff = 0;
             }
 
+            if (payload_coeff_override >= 0)
+                payload_coeff = payload_coeff_override;
+
             for (int i = 0; i < n_vehicles; i++)
             {
                 Vehicle *vehicle = loadVehicle(QString(fs.getModulesDir().c_str()) +
@@ -452,13 +633,16 @@ bool Train::loadTrain(QString cfg_path)
                 index = ode_order;
 
                 // Loading sounds
-                soundMan->loadSounds(vehicle->getSoundsDir());
+                if (soundMan != nullptr)
+                {
+                    soundMan->loadSounds(vehicle->getSoundsDir());
 
-                connect(vehicle, &Vehicle::soundPlay, soundMan, &SoundManager::play, Qt::DirectConnection);
-                connect(vehicle, &Vehicle::soundStop, soundMan, &SoundManager::stop, Qt::DirectConnection);
-                connect(vehicle, &Vehicle::soundSetVolume, soundMan, &SoundManager::setVolume, Qt::DirectConnection);
-                connect(vehicle, &Vehicle::soundSetPitch, soundMan, &SoundManager::setPitch, Qt::DirectConnection);
-                connect(vehicle, &Vehicle::volumeCurveStep, soundMan, &SoundManager::volumeCurveStep, Qt::DirectConnection);
+                    connect(vehicle, &Vehicle::soundPlay, soundMan, &SoundManager::play, Qt::DirectConnection);
+                    connect(vehicle, &Vehicle::soundStop, soundMan, &SoundManager::stop, Qt::DirectConnection);
+                    connect(vehicle, &Vehicle::soundSetVolume, soundMan, &SoundManager::setVolume, Qt::DirectConnection);
+                    connect(vehicle, &Vehicle::soundSetPitch, soundMan, &SoundManager::setPitch, Qt::DirectConnection);
+                    connect(vehicle, &Vehicle::volumeCurveStep, soundMan, &SoundManager::volumeCurveStep, Qt::DirectConnection);
+                }
 
                 if (vehicles.size() !=0)
                 {
@@ -472,13 +656,6 @@ bool Train::loadTrain(QString cfg_path)
 
             vehicle_node = cfg.getNextSection();            
         }        
-
-        for (auto it = vehicles.begin(); it != vehicles.end(); ++it)
-        {
-            Vehicle *vehicle = *it;
-            connect(this, &Train::sendDataToVehicle,
-                    vehicle, &Vehicle::receiveData, Qt::DirectConnection);
-        }
     }
     else
     {
@@ -597,3 +774,127 @@ void Train::initVehiclesBrakes()
         vehicles[i]->initBrakeDevices(charging_pressure, pTM, init_main_res_pressure);
     }
 }
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Train::initMultirate(double t)
+{
+    brakepipe_rate.step = solver_config.brakepipe_step;
+    brakepipe_rate.t = t;
+
+    vehicles_rate.step = solver_config.vehicles_step;
+    vehicles_rate.t = t;
+
+    size_t num_vehicles = vehicles.size();
+
+    p0_signal.reset(1, t, brakepipe->getPressure(0) * Physics::MPa + Physics::pA);
+    aux_rate_signal.reset(num_vehicles, t);
+    pTM_signal.reset(num_vehicles, t);
+
+    for (size_t i = 0; i < num_vehicles; ++i)
+        pTM_signal.set(i, brakepipe->getPressure(i + 1));
+
+    forces_signal.reset(ode_order, t);
+    forces.resize(ode_order);
+
+    storeForces();
+    forces_signal.beginSample(t);
+
+    if (!vehicles_rate.isSynchronous())
+    {
+        Journal::instance()->info(QString("Vehicles are integrated with own step %1")
+                                  .arg(vehicles_rate.step));
+    }
+
+    if (!brakepipe_rate.isSynchronous())
+    {
+        Journal::instance()->info(QString("Brakepipe is integrated with own step %1")
+                                  .arg(brakepipe_rate.step));
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Train::multirateStep(double t)
+{
+    bool is_brakepipe_due = false;
+    bool is_vehicles_due = false;
+
+    do
+    {
+        is_brakepipe_due = !brakepipe_rate.isSynchronous() &&
+                brakepipe_rate.isDue(t);
+
+        is_vehicles_due = !vehicles_rate.isSynchronous() &&
+                vehicles_rate.isDue(t);
+
+        // Group, which is late more, goes first
+        if (is_brakepipe_due &&
+            (!is_vehicles_due || (brakepipe_rate.t <= vehicles_rate.t)))
+        {
+            brakepipeStep(brakepipe_rate.t, brakepipe_rate.step);
+            brakepipe_rate.t += brakepipe_rate.step;
+            continue;
+        }
+
+        if (is_vehicles_due)
+        {
+            vehiclesStep(vehicles_rate.t, vehicles_rate.step);
+            vehicles_rate.t += vehicles_rate.step;
+        }
+
+    } while (is_brakepipe_due || is_vehicles_due);
+
+    if (!vehicles_rate.isSynchronous())
+        setInterpolatedForces(t);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Train::storeForces()
+{
+    for (auto vehicle : vehicles)
+    {
+        size_t idx = vehicle->getIndex();
+        size_t s = vehicle->getDegressOfFreedom();
+
+        const state_vector_t &Q_a = vehicle->getActiveCommonForces();
+        const state_vector_t &Q_r = vehicle->getReactiveCommonForces();
+
+        std::copy(Q_a.begin(), Q_a.end(), forces_signal.lastData() + idx);
+        std::copy(Q_r.begin(), Q_r.end(), forces_signal.lastData() + idx + s);
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Train::sampleBrakepipeInputs(double t)
+{
+    p0_signal.beginSample(t);
+    p0_signal.set(0, vehicles.front()->getBrakepipeBeginPressure());
+
+    aux_rate_signal.beginSample(t);
+
+    for (size_t i = 0; i < vehicles.size(); ++i)
+        aux_rate_signal.set(i, vehicles[i]->getBrakepipeAuxRate());
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Train::setInterpolatedForces(double t)
+{
+    forces_signal.get(t, forces.data());
+
+    for (auto vehicle : vehicles)
+    {
+        size_t idx = vehicle->getIndex();
+        size_t s = vehicle->getDegressOfFreedom();
+
+        vehicle->setCommonForces(forces.data() + idx, forces.data() + idx + s);
+    }
+}
@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+//
+//      Fixed pool of worker threads for parallel loops
+//      (c) maisvendoo
+//
+//------------------------------------------------------------------------------
+/*!
+ * \file
+ * \brief Fixed pool of worker threads for parallel loops
+ * \copyright maisvendoo
+ */
+
+#include    "worker-pool.h"
+
+#include    <algorithm>
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+WorkerPool::WorkerPool(size_t threads_num)
+    : threads_num(std::max(threads_num, static_cast<size_t>(1)))
+    , queues(new worker_queue_t[std::max(threads_num, static_cast<size_t>(1))])
+    , generation(0)
+    , active(0)
+    , is_stopped(false)
+    , task_ctx(nullptr)
+    , task_call(nullptr)
+{
+    for (size_t w = 1; w < this->threads_num; ++w)
+        threads.emplace_back(&WorkerPool::loop, this, w);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+WorkerPool::~WorkerPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        is_stopped = true;
+    }
+
+    start_cond.notify_all();
+
+    for (auto &thread : threads)
+        thread.join();
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+size_t WorkerPool::getThreadsNum() const
+{
+    return threads_num;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void WorkerPool::run(size_t n, void *ctx, task_call_t call)
+{
+    if ( (threads_num == 1) || (n < 2) )
+    {
+        for (size_t i = 0; i < n; ++i)
+            call(ctx, i);
+
+        return;
+    }
+
+    // Contiguous parts of index range
+    for (size_t w = 0; w < threads_num; ++w)
+    {
+        queues[w].next.store(n * w / threads_num, std::memory_order_relaxed);
+        queues[w].end = n * (w + 1) / threads_num;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        task_ctx = ctx;
+        task_call = call;
+        active = threads_num - 1;
+        ++generation;
+    }
+
+    start_cond.notify_all();
+
+    work(0);
+
+    // Barrier: wait for all workers
+    std::unique_lock<std::mutex> lock(mutex);
+    done_cond.wait(lock, [this] { return active == 0; });
+    task_ctx = nullptr;
+    task_call = nullptr;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void WorkerPool::loop(size_t w)
+{
+    size_t last_generation = 0;
+
+    while (true)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+
+            start_cond.wait(lock, [this, last_generation] {
+                return is_stopped || (generation != last_generation);
+            });
+
+            if (is_stopped)
+                return;
+
+            last_generation = generation;
+        }
+
+        work(w);
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+
+            if (--active == 0)
+                done_cond.notify_one();
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void WorkerPool::work(size_t w)
+{
+    void *ctx = task_ctx;
+    task_call_t call = task_call;
+
+    for (size_t k = 0; k < threads_num; ++k)
+    {
+        // Own part first, then parts of other workers
+        worker_queue_t &queue = queues[(w + k) % threads_num];
+
+        size_t i = queue.next.fetch_add(1, std::memory_order_relaxed);
+
+        while (i < queue.end)
+        {
+            call(ctx, i);
+            i = queue.next.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
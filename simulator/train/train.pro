@@ -3,8 +3,16 @@ TEMPLATE = lib
 QT -= gui
 QT += xml
 
+CONFIG += c++11
+
 DEFINES += TRAIN_LIB
 
+# Step profiler instrumentation (qmake CONFIG+=step_profiler)
+step_profiler {
+
+    DEFINES += STEP_PROFILER
+}
+
 TARGET = train
 
 DESTDIR = ../../../lib
@@ -15,6 +23,7 @@ CONFIG(debug, debug|release) {
     LIBS += -L../../../lib -lCfgReader_d
     LIBS += -L../../../lib -lfilesystem_d
     LIBS += -L../../../lib -lJournal_d
+    LIBS += -L../../../lib -lplugin-loader_d
     LIBS += -L../../../lib -lphysics_d
     LIBS += -L../../../lib -lvehicle_d
     LIBS += -L../../../lib -lcoupling_d
@@ -31,6 +40,7 @@ CONFIG(debug, debug|release) {
     LIBS += -L../../../lib -lCfgReader
     LIBS += -L../../../lib -lfilesystem
     LIBS += -L../../../lib -lJournal
+    LIBS += -L../../../lib -lplugin-loader
     LIBS += -L../../../lib -lphysics
     LIBS += -L../../../lib -lvehicle
     LIBS += -L../../../lib -lcoupling
@@ -70,6 +80,7 @@ INCLUDEPATH += ../device/include
 INCLUDEPATH += ../../CfgReader/include
 INCLUDEPATH += ../../filesystem/include
 INCLUDEPATH += ../../libJournal/include
+INCLUDEPATH += ../../plugin-loader/include
 
 INCLUDEPATH += ../sound-manager/include
 INCLUDEPATH += ../../asound/include
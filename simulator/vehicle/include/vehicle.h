@@ -23,6 +23,7 @@
 
 #include    "solver-types.h"
 #include    "key-symbols.h"
+#include    "keys-state.h"
 
 #include    "vehicle-signals.h"
 #include    "control-signals.h"
@@ -71,6 +72,9 @@ public:
     /// Set backward coupling force
     void setBackwardForce(double R2);
 
+    /// Get backward coupling force
+    double getBackwardForce() const;
+
     /// Set active common force
     void setActiveCommonForce(size_t idx, double value);
 
@@ -92,6 +96,8 @@ public:
 
     void setConfigDir(QString config_dir);
 
+    QString getConfigDir() const;
+
     /// Get vehicle index
     size_t getIndex() const;
 
@@ -107,6 +113,27 @@ public:
     /// Get wheel diameter
     double getWheelDiameter() const;
 
+    /// Get wheel radius
+    double getWheelRadius() const;
+
+    /// Get number of axis
+    size_t getNumAxis() const;
+
+    /// Get axis moment of inertia
+    double getAxisInertia() const;
+
+    /// Get main resistence formula coefficients
+    void getMainResist(double &b0, double &b1, double &b2, double &b3, double &q0) const;
+
+    /// Get active common forces
+    const state_vector_t &getActiveCommonForces() const;
+
+    /// Get reactive common forces
+    const state_vector_t &getReactiveCommonForces() const;
+
+    /// Set active and reactive common forces
+    void setCommonForces(const double *Q_a, const double *Q_r);
+
     double getRailwayCoord() const;
 
     double getVelocity() const;
@@ -122,9 +149,33 @@ public:
     std::array<bool, MAX_DISCRETE_SIGNALS> getDiscreteSignals();
     std::array<float, MAX_ANALOG_SIGNALS> getAnalogSignals();
 
-    /// Common acceleration calculation
+    /*!
+     * \brief Common acceleration calculation (legacy API)
+     *
+     * Returns acceleration vector by value, so memory is allocated on each
+     * call. Kept for vehicle modules, which override it. New code should
+     * override calcAcceleration() instead
+     */
     virtual state_vector_t getAcceleration(state_vector_t &Y, double t);
 
+    /*!
+     * \brief Common acceleration calculation
+     * \param Y - train state vector
+     * \param t - current time
+     * \param acceleration - output buffer for s accelerations of this vehicle
+     *
+     * Writes accelerations directly into caller's memory (usually into
+     * dYdt slice of vehicle). Base implementation calls getAcceleration(),
+     * so modules, overriding legacy API, keep working. Module takes
+     * allocation-free path by overriding this method (common part is
+     * baseAcceleration()) or by call of setNativeAcceleration(true), if it
+     * doesn't override getAcceleration()
+     */
+    virtual void calcAcceleration(state_vector_t &Y, double t, double *acceleration);
+
+    /// Vehicle uses only base motion equations (setNativeAcceleration(true))
+    bool isNativeAcceleration() const;
+
     ///
     void integrationPreStep(state_vector_t &Y, double t);
 
@@ -167,9 +218,10 @@ public:
 
     void setASLN(alsn_info_t alsn_info);
 
+    /// Set keyboard state, shared by all vehicles
+    void setKeysState(const KeysState *keys);
+
 public slots:
-    
-    void receiveData(QByteArray data);
 
     void getControlSignals(control_signals_t control_signals);
 
@@ -255,6 +307,13 @@ protected:
 
     QString DebugMsg;
 
+    /*!
+     * Neighbour vehicles. With VehiclesThreads > 1 in train config, steps of
+     * vehicles run concurrently, so step() of module must not read or write
+     * state of neighbours (as well as static or global state), and sound
+     * signals, emitted from step(), must be thread-safe for receiver.
+     * Modules, which use neighbours in step(), require VehiclesThreads = 1
+     */
     Vehicle *prev_vehicle;
     Vehicle *next_vehicle;
 
@@ -278,9 +337,15 @@ protected:
     /// Vehicle common acceleration
     state_vector_t  a;
 
-    /// Keyboard state
-    QMap<int, bool> keys;
-    QMutex          keys_mutex;    
+    /// Base class acceleration calculation into output buffer
+    void baseAcceleration(state_vector_t &Y, double t, double *acceleration);
+
+    /// Module doesn't override getAcceleration(), so base calcAcceleration()
+    /// may calculate acceleration without legacy call
+    void setNativeAcceleration(bool is_native);
+
+    /// Keyboard state (read only view, updated by model between steps)
+    const KeysState *keys;
 
     /// Discrete signals for outpput
     std::array<bool, MAX_DISCRETE_SIGNALS>  discreteSignal;
@@ -329,6 +394,9 @@ protected:
 
 private:
 
+    /// Base calcAcceleration() doesn't call getAcceleration()
+    bool    is_native_acceleration;
+
     /// Default configuration load
     void loadConfiguration(QString cfg_path);
 
@@ -18,11 +18,12 @@
 #include    "CfgReader.h"
 #include    "physics.h"
 #include    "Journal.h"
+#include    "module-registry.h"
 
-#include    <QLibrary>
 #include    <QDir>
 #include    <QFileInfo>
-#include    <QDataStream>
+
+#include    <cstring>
 
 //------------------------------------------------------------------------------
 //
@@ -61,6 +62,8 @@ Vehicle::Vehicle(QObject *parent) : QObject(parent)
   , config_dir("")
   , Uks(0.0)
   , current_kind(0)
+  , keys(nullptr)
+  , is_native_acceleration(false)
 {
     std::fill(analogSignal.begin(), analogSignal.end(), 0.0f);
     std::fill(discreteSignal.begin(), discreteSignal.end(), false);
@@ -136,6 +139,14 @@ void Vehicle::setBackwardForce(double R2)
     this->R2 = R2;
 }
 
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+double Vehicle::getBackwardForce() const
+{
+    return R2;
+}
+
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
@@ -221,6 +232,14 @@ void Vehicle::setConfigDir(QString config_dir)
     this->config_dir = config_dir;
 }
 
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+QString Vehicle::getConfigDir() const
+{
+    return config_dir;
+}
+
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
@@ -261,6 +280,67 @@ double Vehicle::getWheelDiameter() const
     return wheel_diameter;
 }
 
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+double Vehicle::getWheelRadius() const
+{
+    return rk;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+size_t Vehicle::getNumAxis() const
+{
+    return num_axis;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+double Vehicle::getAxisInertia() const
+{
+    return J_axis;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Vehicle::getMainResist(double &b0, double &b1, double &b2, double &b3, double &q0) const
+{
+    b0 = this->b0;
+    b1 = this->b1;
+    b2 = this->b2;
+    b3 = this->b3;
+    q0 = this->q0;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const state_vector_t &Vehicle::getActiveCommonForces() const
+{
+    return Q_a;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+const state_vector_t &Vehicle::getReactiveCommonForces() const
+{
+    return Q_r;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Vehicle::setCommonForces(const double *Q_a, const double *Q_r)
+{
+    memcpy(this->Q_a.data(), Q_a, sizeof(double) * this->Q_a.size());
+    memcpy(this->Q_r.data(), Q_r, sizeof(double) * this->Q_r.size());
+}
+
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
@@ -325,6 +405,48 @@ float Vehicle::getAnalogSignal(size_t i)
 //
 //------------------------------------------------------------------------------
 state_vector_t Vehicle::getAcceleration(state_vector_t &Y, double t)
+{
+    baseAcceleration(Y, t, a.data());
+
+    return a;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Vehicle::calcAcceleration(state_vector_t &Y, double t, double *acceleration)
+{
+    if (is_native_acceleration)
+    {
+        baseAcceleration(Y, t, acceleration);
+        return;
+    }
+
+    // Legacy API may be overridden by vehicle module
+    state_vector_t acc = getAcceleration(Y, t);
+    memcpy(acceleration, acc.data(), sizeof(double) * s);
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Vehicle::setNativeAcceleration(bool is_native)
+{
+    is_native_acceleration = is_native;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+bool Vehicle::isNativeAcceleration() const
+{
+    return is_native_acceleration;
+}
+
+//------------------------------------------------------------------------------
+//
+//------------------------------------------------------------------------------
+void Vehicle::baseAcceleration(state_vector_t &Y, double t, double *acceleration)
 {
     (void) t;
 
@@ -356,14 +478,11 @@ state_vector_t Vehicle::getAcceleration(state_vector_t &Y, double t)
     double Fr = Physics::fricForce(W + Q_r[0], dir * v);
 
     // Vehicle body's acceleration
-    *a.begin() = dir * (*Q_a.begin() - Fr + R1 - R2 + sumEqWheelForce - G) / ( full_mass + num_axis * J_axis / rk / rk);
+    acceleration[0] = dir * (Q_a[0] - Fr + R1 - R2 + sumEqWheelForce - G) / ( full_mass + num_axis * J_axis / rk / rk);
 
     // Wheels angle accelerations
-    auto end = a.end();
-    for (auto accel_it = a.begin() + 1; accel_it != end; ++accel_it)
-        *accel_it = *a.begin() / rk;
-
-    return a;
+    for (size_t i = 1; i < s; ++i)
+        acceleration[i] = acceleration[0] / rk;
 }
 
 //------------------------------------------------------------------------------
@@ -451,17 +570,9 @@ QString Vehicle::getDebugMsg() const
 //------------------------------------------------------------------------------
 //
 //------------------------------------------------------------------------------
-void Vehicle::receiveData(QByteArray data)
+void Vehicle::setKeysState(const KeysState *keys)
 {
-    if (data.size() == 0)
-        return;
-
-    keys_mutex.lock();
-
-    QDataStream stream(&data, QIODevice::ReadOnly);
-    stream >> keys;
-
-    keys_mutex.unlock();
+    this->keys = keys;
 }
 
 //------------------------------------------------------------------------------
@@ -663,24 +774,11 @@ Vehicle *loadVehicle(QString lib_path)
 {
     Vehicle *vehicle = nullptr;
 
-    QLibrary lib(lib_path);
+    GetVehicle getVehicle = ModuleRegistry::instance()->resolve<GetVehicle>(lib_path, "getVehicle");
 
-    if (lib.load())
-    {
-        GetVehicle getVehicle = reinterpret_cast<GetVehicle>(lib.resolve("getVehicle"));
-
-        if (getVehicle)
-        {
-            vehicle = getVehicle();
-        }
-        else
-        {
-            Journal::instance()->error(lib.errorString());
-        }
-    }
-    else
+    if (getVehicle)
     {
-        Journal::instance()->error(lib.errorString());
+        vehicle = getVehicle();
     }
 
     return vehicle;
@@ -750,12 +848,10 @@ bool Vehicle::isAlt() const
 //------------------------------------------------------------------------------
 bool Vehicle::getKeyState(int key) const
 {
-    auto it = keys.find(key);
-
-    if ( it != keys.end() )
-        return it.value();
+    if (keys == nullptr)
+        return false;
 
-    return false;
+    return keys->getKeyState(key);
 }
 
 //------------------------------------------------------------------------------
@@ -16,6 +16,7 @@ CONFIG(debug, debug|release) {
     LIBS += -L../../../lib -lphysics_d
     LIBS += -L../../../lib -ldevice_d
     LIBS += -L../../../lib -lJournal_d
+    LIBS += -L../../../lib -lplugin-loader_d
 
 } else {
 
@@ -23,6 +24,7 @@ CONFIG(debug, debug|release) {
     LIBS += -L../../../lib -lphysics
     LIBS += -L../../../lib -ldevice
     LIBS += -L../../../lib -lJournal
+    LIBS += -L../../../lib -lplugin-loader
 }
 
 INCLUDEPATH += ./include
@@ -31,6 +33,7 @@ INCLUDEPATH += ../physics/include
 INCLUDEPATH += ../device/include
 INCLUDEPATH += ../../CfgReader/include
 INCLUDEPATH += ../../libJournal/include
+INCLUDEPATH += ../../plugin-loader/include
 
 HEADERS += $$files(./include/*.h)
 SOURCES += $$files(./src/*.cpp)